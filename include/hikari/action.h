@@ -10,9 +10,17 @@ struct hikari_event_action {
   void *arg;
 };
 
+// a rate of 0 disables repeating the begin action while the key is held.
+struct hikari_action_repeat {
+  int delay;
+  int rate;
+  int acceleration;
+};
+
 struct hikari_action {
   struct hikari_event_action begin;
   struct hikari_event_action end;
+  struct hikari_action_repeat repeat;
 };
 
 void
@@ -1,6 +1,7 @@
 #if !defined(HIKARI_BINDING_GROUP_H)
 #define HIKARI_BINDING_GROUP_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 struct hikari_binding;
@@ -10,6 +11,9 @@ struct hikari_binding;
 struct hikari_binding_group {
   int nbindings;
   struct hikari_binding *bindings;
+
+  uint32_t table_size;
+  struct hikari_binding **table;
 };
 
 void
@@ -18,4 +22,18 @@ hikari_binding_group_init(struct hikari_binding_group *binding_group);
 void
 hikari_binding_group_fini(struct hikari_binding_group *binding_group);
 
+void
+hikari_binding_group_index(struct hikari_binding_group *binding_group);
+
+static inline struct hikari_binding *
+hikari_binding_group_find(
+    struct hikari_binding_group *binding_group, uint32_t code)
+{
+  if (code >= binding_group->table_size) {
+    return NULL;
+  }
+
+  return binding_group->table[code];
+}
+
 #endif
@@ -32,6 +32,8 @@ struct hikari_configuration {
   int gap;
   int step;
 
+  char *screenshot_directory;
+
   struct hikari_exec execs[HIKARI_NR_OF_EXECS];
 
   struct wl_list view_configs;
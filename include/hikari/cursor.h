@@ -20,6 +20,10 @@ struct hikari_cursor {
   struct wl_listener surface_destroy;
   struct wl_listener request_set_cursor;
 
+  struct wl_event_source *motion_idle;
+  uint32_t motion_time_msec;
+  bool frame_pending;
+
   struct hikari_binding_group bindings[HIKARI_BINDING_GROUP_MASK];
 };
 
@@ -43,6 +47,9 @@ hikari_cursor_deactivate(struct hikari_cursor *cursor);
 void
 hikari_cursor_set_image(struct hikari_cursor *cursor, const char *path);
 
+void
+hikari_cursor_flush_motion(struct hikari_cursor *cursor);
+
 void
 hikari_cursor_center(struct hikari_cursor *cursor,
     struct hikari_output *output,
@@ -0,0 +1,14 @@
+#if !defined(HIKARI_FRACTIONAL_SCALE_H)
+#define HIKARI_FRACTIONAL_SCALE_H
+
+#include <wayland-server-core.h>
+
+#include <wlr/types/wlr_surface.h>
+
+struct wl_global *
+hikari_fractional_scale_manager_create(struct wl_display *display);
+
+void
+hikari_fractional_scale_notify(struct wlr_surface *surface, double scale);
+
+#endif
@@ -14,6 +14,14 @@ struct hikari_indicator {
   struct hikari_indicator_bar sheet;
   struct hikari_indicator_bar group;
   struct hikari_indicator_bar mark;
+
+  // set when the focus view changed while no indication was shown, textures
+  // are rasterized once indication becomes visible.
+  bool stale;
+
+  // set when the title of the focus view changed while indication is shown,
+  // the title is rasterized once on the next frame of its output.
+  bool title_pending;
 };
 
 void
@@ -27,6 +35,20 @@ void
 hikari_indicator_update(
     struct hikari_indicator *indicator, struct hikari_view *view);
 
+void
+hikari_indicator_refresh(
+    struct hikari_indicator *indicator, struct hikari_view *view);
+
+void
+hikari_indicator_commit_title(
+    struct hikari_indicator *indicator, struct hikari_output *output);
+
+static inline void
+hikari_indicator_invalidate(struct hikari_indicator *indicator)
+{
+  indicator->stale = true;
+}
+
 void
 hikari_indicator_set_color(
     struct hikari_indicator *indicator, float color[static 4]);
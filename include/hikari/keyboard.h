@@ -11,6 +11,13 @@
 #include <hikari/binding_group.h>
 #include <hikari/keyboard_config.h>
 
+struct hikari_keyboard_group;
+
+struct hikari_keysym_entry {
+  xkb_keysym_t keysym;
+  uint32_t keycode;
+};
+
 struct hikari_keyboard {
   struct wl_list server_keyboards;
   struct wlr_input_device *device;
@@ -21,6 +28,20 @@ struct hikari_keyboard {
 
   struct xkb_keymap *keymap;
 
+  // devices with identical keymap and repeat settings share a keyboard
+  // group, switching between them does not resend the keymap to clients.
+  struct hikari_keyboard_group *group;
+
+  // keysyms of the keymap sorted by keysym and keycode, used to resolve
+  // keysym bindings.
+  size_t nkeysyms;
+  struct hikari_keysym_entry *keysyms;
+
+#ifndef NDEBUG
+  // time it took to resolve the bindings of the last configuration.
+  long binding_resolution_usec;
+#endif
+
   struct hikari_binding_group bindings[HIKARI_BINDING_GROUP_MASK];
 };
 
@@ -35,6 +56,9 @@ void
 hikari_keyboard_configure(struct hikari_keyboard *keyboard,
     struct hikari_keyboard_config *keyboard_config);
 
+void
+hikari_keyboard_activate(struct hikari_keyboard *keyboard);
+
 void
 hikari_keyboard_configure_bindings(
     struct hikari_keyboard *keyboard, struct wl_list *bindings);
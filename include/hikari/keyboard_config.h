@@ -69,4 +69,10 @@ bool
 hikari_keyboard_config_compile_keymap(
     struct hikari_keyboard_config *keyboard_config);
 
+void
+hikari_keymaps_prune(struct wl_list *keyboard_configs);
+
+void
+hikari_keymaps_fini(void);
+
 #endif
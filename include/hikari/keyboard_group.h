@@ -0,0 +1,32 @@
+#if !defined(HIKARI_KEYBOARD_GROUP_H)
+#define HIKARI_KEYBOARD_GROUP_H
+
+#include <stdbool.h>
+
+#include <wayland-util.h>
+#include <xkbcommon/xkbcommon.h>
+
+#include <wlr/types/wlr_keyboard_group.h>
+
+struct hikari_keyboard;
+
+struct hikari_keyboard_group {
+  struct wl_list server_keyboard_groups;
+
+  struct wlr_keyboard_group *wlr_keyboard_group;
+  int nr_keyboards;
+};
+
+bool
+hikari_keyboard_group_matches(struct hikari_keyboard_group *keyboard_group,
+    struct xkb_keymap *keymap,
+    int repeat_rate,
+    int repeat_delay);
+
+void
+hikari_keyboard_group_join(struct hikari_keyboard *keyboard);
+
+void
+hikari_keyboard_group_leave(struct hikari_keyboard *keyboard);
+
+#endif
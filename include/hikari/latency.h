@@ -0,0 +1,72 @@
+#if !defined(HIKARI_LATENCY_H)
+#define HIKARI_LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+enum hikari_latency_event_type {
+  HIKARI_LATENCY_EVENT_KEY,
+  HIKARI_LATENCY_EVENT_BUTTON,
+  HIKARI_LATENCY_EVENT_MOTION,
+  HIKARI_LATENCY_EVENT_TYPES
+};
+
+#define HIKARI_LATENCY_MODES 11
+
+// bucket `i` counts latencies below `2^i` milliseconds, the last bucket
+// counts everything else.
+#define HIKARI_LATENCY_BUCKETS 12
+
+struct hikari_latency_input {
+  bool valid;
+  bool tagged;
+  unsigned long seq;
+  enum hikari_latency_event_type type;
+  int mode;
+  uint32_t time_msec;
+};
+
+struct hikari_latency {
+  unsigned long tagged_seq;
+
+  // input reflected by damage that has not been rendered yet and input
+  // reflected by the frame that has been committed but not presented.
+  struct hikari_latency_input damaged;
+  struct hikari_latency_input committed;
+
+  unsigned long histograms[HIKARI_LATENCY_EVENT_TYPES][HIKARI_LATENCY_MODES]
+                          [HIKARI_LATENCY_BUCKETS];
+};
+
+#ifndef NDEBUG
+void
+hikari_latency_init(struct hikari_latency *latency);
+
+void
+hikari_latency_input(enum hikari_latency_event_type type, uint32_t time_msec);
+
+void
+hikari_latency_damage(struct hikari_latency *latency);
+
+void
+hikari_latency_commit(struct hikari_latency *latency);
+
+void
+hikari_latency_present(struct hikari_latency *latency, struct timespec *when);
+
+void
+hikari_latency_dump(struct hikari_latency *latency, const char *output_name);
+#else
+// outputs only carry latency state in debug builds, the arguments must not
+// be evaluated.
+#define hikari_latency_init(latency) ((void)0)
+#define hikari_latency_damage(latency) ((void)0)
+#define hikari_latency_commit(latency) ((void)0)
+
+static inline void
+hikari_latency_input(enum hikari_latency_event_type type, uint32_t time_msec)
+{}
+#endif
+
+#endif
@@ -37,10 +37,12 @@ struct hikari_layer {
   struct wl_listener new_popup;
 
   struct wlr_box geometry;
+  struct wlr_layer_surface_v1_state state;
 
   struct hikari_output *output;
   enum zwlr_layer_shell_v1_layer layer;
   bool mapped;
+  bool arranged;
 };
 
 struct hikari_layer_popup {
@@ -62,4 +64,7 @@ hikari_layer_init(struct hikari_layer *layer_surface,
 void
 hikari_layer_fini(struct hikari_layer *layer_surface);
 
+void
+hikari_layer_shell_arrange(struct hikari_output *output);
+
 #endif
@@ -9,6 +9,9 @@ hikari_malloc(size_t size);
 void *
 hikari_calloc(size_t number, size_t size);
 
+void *
+hikari_realloc(void *ptr, size_t size);
+
 void
 hikari_free(void *ptr);
 
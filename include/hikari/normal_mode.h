@@ -1,13 +1,22 @@
 #if !defined(HIKARI_NORMAL_MODE_H)
 #define HIKARI_NORMAL_MODE_H
 
-#include <hikari/mode.h>
+#include <time.h>
+
+#include <wayland-server-core.h>
 
-struct hikari_event_action;
+#include <hikari/action.h>
+#include <hikari/mode.h>
 
 struct hikari_normal_mode {
   struct hikari_mode mode;
   struct hikari_event_action *pending_action;
+
+  // copy of the action that is repeated while its key is held.
+  struct hikari_action repeat_action;
+  uint32_t repeat_keycode;
+  struct wl_event_source *repeat_timer;
+  struct timespec repeat_start;
 };
 
 void
@@ -16,4 +25,7 @@ hikari_normal_mode_init(struct hikari_normal_mode *normal_mode);
 void
 hikari_normal_mode_enter(void);
 
+void
+hikari_normal_mode_stop_repeat(struct hikari_normal_mode *normal_mode);
+
 #endif
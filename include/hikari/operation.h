@@ -1,6 +1,10 @@
 #if !defined(HIKARI_OPERATION_H)
 #define HIKARI_OPERATION_H
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
 #include <wlr/util/box.h>
 
 struct hikari_tile;
@@ -20,6 +24,7 @@ struct hikari_operation {
   bool dirty;
   bool center;
   uint32_t serial;
+  struct timespec issued;
   struct wlr_box geometry;
   struct hikari_tile *tile;
 };
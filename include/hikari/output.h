@@ -2,14 +2,20 @@
 #define HIKARI_OUTPUT_H
 
 #include <assert.h>
+#include <math.h>
+#include <time.h>
 
 #include <wayland-server-core.h>
 #include <wayland-util.h>
 
 #include <wlr/types/wlr_output_damage.h>
 #include <wlr/types/wlr_surface.h>
+#include <wlr/util/region.h>
 
+#include <hikari/latency.h>
 #include <hikari/output_config.h>
+#include <hikari/screenshot.h>
+#include <hikari/spatial_index.h>
 
 struct hikari_renderer;
 
@@ -23,6 +29,9 @@ struct hikari_output {
   struct wl_listener damage_frame;
   struct wl_listener destroy;
   struct wl_listener damage_destroy;
+#ifndef NDEBUG
+  struct wl_listener present;
+#endif
   /* struct wl_listener mode; */
 
 #ifdef HAVE_LAYERSHELL
@@ -39,6 +48,20 @@ struct hikari_output {
   struct wlr_box usable_area;
 
   struct wlr_texture *background;
+
+  bool damage_deferred;
+  pixman_region32_t deferred_damage;
+
+  int max_fps;
+  bool frame_limited;
+  struct timespec last_frame;
+  struct wl_event_source *frame_timer;
+
+  struct hikari_screenshot screenshot;
+  struct hikari_spatial_index spatial_index;
+#ifndef NDEBUG
+  struct hikari_latency latency;
+#endif
 };
 
 void
@@ -50,6 +73,9 @@ hikari_output_fini(struct hikari_output *output);
 void
 hikari_output_damage_whole(struct hikari_output *output);
 
+void
+hikari_output_refresh_geometry(struct hikari_output *output);
+
 void
 hikari_output_disable(struct hikari_output *output);
 
@@ -64,6 +90,24 @@ hikari_output_load_background(struct hikari_output *output,
 void
 hikari_output_move(struct hikari_output *output, double lx, double ly);
 
+void
+hikari_output_set_scale(struct hikari_output *output, double scale);
+
+void
+hikari_output_defer_damage(struct hikari_output *output);
+
+void
+hikari_output_flush_damage(struct hikari_output *output);
+
+void
+hikari_output_set_max_fps(struct hikari_output *output, int max_fps);
+
+void
+hikari_output_toggle_max_fps(struct hikari_output *output);
+
+bool
+hikari_output_throttle_frame(struct hikari_output *output);
+
 struct hikari_output *
 hikari_output_next(struct hikari_output *output);
 
@@ -75,6 +119,30 @@ void
 hikari_output_rearrange_xwayland_views(struct hikari_output *output);
 #endif
 
+// converts a box in output layout coordinates into buffer coordinates, the
+// result covers every pixel the box touches.
+static inline void
+hikari_output_scale_box(
+    struct hikari_output *output, struct wlr_box *box, struct wlr_box *scaled)
+{
+  float scale = output->wlr_output->scale;
+
+  if (scale == 1) {
+    *scaled = *box;
+    return;
+  }
+
+  int x1 = floor(box->x * scale);
+  int y1 = floor(box->y * scale);
+  int x2 = ceil((box->x + box->width) * scale);
+  int y2 = ceil((box->y + box->height) * scale);
+
+  scaled->x = x1;
+  scaled->y = y1;
+  scaled->width = x2 - x1;
+  scaled->height = y2 - y1;
+}
+
 static inline void
 hikari_output_add_damage(struct hikari_output *output, struct wlr_box *region)
 {
@@ -82,7 +150,46 @@ hikari_output_add_damage(struct hikari_output *output, struct wlr_box *region)
   assert(region != NULL);
 
   if (output->enabled) {
-    wlr_output_damage_add_box(output->damage, region);
+    hikari_latency_damage(&output->latency);
+
+    struct wlr_box box;
+    hikari_output_scale_box(output, region, &box);
+
+    if (output->damage_deferred) {
+      pixman_region32_union_rect(&output->deferred_damage,
+          &output->deferred_damage,
+          box.x,
+          box.y,
+          box.width,
+          box.height);
+    } else {
+      wlr_output_damage_add_box(output->damage, &box);
+    }
+  }
+}
+
+static inline void
+hikari_output_add_damage_region(
+    struct hikari_output *output, pixman_region32_t *region)
+{
+  assert(output != NULL);
+  assert(region != NULL);
+
+  if (output->enabled) {
+    hikari_latency_damage(&output->latency);
+
+    pixman_region32_t damage;
+    pixman_region32_init(&damage);
+    wlr_region_scale(&damage, region, output->wlr_output->scale);
+
+    if (output->damage_deferred) {
+      pixman_region32_union(
+          &output->deferred_damage, &output->deferred_damage, &damage);
+    } else {
+      wlr_output_damage_add(output->damage, &damage);
+    }
+
+    pixman_region32_fini(&damage);
   }
 }
 
@@ -105,7 +212,15 @@ hikari_output_add_effective_surface_damage(
   pixman_region32_t damage;
   pixman_region32_init(&damage);
   wlr_surface_get_effective_damage(surface, &damage);
-  pixman_region32_translate(&damage, x, y);
+
+  float scale = output->wlr_output->scale;
+  if (scale != 1) {
+    wlr_region_scale(&damage, &damage, scale);
+  }
+  pixman_region32_translate(&damage, floor(x * scale), floor(y * scale));
+  if (pixman_region32_not_empty(&damage)) {
+    hikari_latency_damage(&output->latency);
+  }
   wlr_output_damage_add(output->damage, &damage);
   pixman_region32_fini(&damage);
 }
@@ -22,6 +22,8 @@ struct hikari_output_config {
   HIKARI_OPTION(background, char *);
   HIKARI_OPTION(background_fit, enum hikari_background_fit);
   HIKARI_OPTION(position, struct hikari_position_config);
+  HIKARI_OPTION(scale, double);
+  HIKARI_OPTION(max_fps, int);
 };
 
 void
@@ -38,5 +40,7 @@ hikari_output_config_merge(struct hikari_output_config *output_config,
 HIKARI_OPTION_FUNS(output, background, char *);
 HIKARI_OPTION_FUNS(output, background_fit, enum hikari_background_fit);
 HIKARI_OPTION_FUNS(output, position, struct hikari_position_config);
+HIKARI_OPTION_FUNS(output, scale, double);
+HIKARI_OPTION_FUNS(output, max_fps, int);
 
 #endif
@@ -0,0 +1,27 @@
+#if !defined(HIKARI_SCREENSHOT_H)
+#define HIKARI_SCREENSHOT_H
+
+#include <stdbool.h>
+
+#include <wlr/render/wlr_renderer.h>
+#include <wlr/util/box.h>
+
+struct hikari_output;
+
+struct hikari_screenshot {
+  bool pending;
+  struct wlr_box geometry;
+};
+
+void
+hikari_screenshot_init(struct hikari_screenshot *screenshot);
+
+void
+hikari_screenshot_request(
+    struct hikari_output *output, struct wlr_box *geometry);
+
+void
+hikari_screenshot_capture(
+    struct hikari_output *output, struct wlr_renderer *wlr_renderer);
+
+#endif
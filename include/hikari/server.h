@@ -23,6 +23,7 @@
 #include <hikari/normal_mode.h>
 #include <hikari/resize_mode.h>
 #include <hikari/sheet_assign_mode.h>
+#include <hikari/transaction.h>
 #include <hikari/workspace.h>
 
 #ifdef HAVE_LAYERSHELL
@@ -38,14 +39,24 @@ struct hikari_server {
   bool cycling;
 #ifndef NDEBUG
   bool track_damage;
+
+  struct {
+    unsigned long moves;
+    unsigned long move_damage_submissions;
+    unsigned long cursor_focus_requests;
+    unsigned long cursor_focus_updates;
+    unsigned long indicator_rasterizations;
+  } statistics;
 #endif
 
   const char *socket;
   char *config_path;
 
   struct wl_event_source *shutdown_timer;
+  struct wl_event_source *cursor_focus_idle;
 
   struct hikari_indicator indicator;
+  struct hikari_transaction transaction;
 
   struct wl_display *display;
   struct wl_event_loop *event_loop;
@@ -88,6 +99,7 @@ struct hikari_server {
 #endif
 
   struct wlr_compositor *compositor;
+  struct wlr_viewporter *viewporter;
   struct wlr_server_decoration_manager *decoration_manager;
   struct wlr_xdg_decoration_manager_v1 *xdg_decoration_manager;
 
@@ -103,6 +115,7 @@ struct hikari_server {
 
   struct wl_list pointers;
   struct wl_list keyboards;
+  struct wl_list keyboard_groups;
   struct wl_list switches;
   struct wl_list outputs;
 
@@ -134,12 +147,6 @@ struct hikari_server {
 
 extern struct hikari_server hikari_server;
 
-static inline bool
-hikari_server_is_indicating(void)
-{
-  return hikari_server.keyboard_state.mod_pressed;
-}
-
 static inline bool
 hikari_server_is_cycling(void)
 {
@@ -176,6 +183,15 @@ hikari_server_node_at(double x,
     double *sx,
     double *sy);
 
+bool
+hikari_server_exposed_surface_box(struct hikari_node *node,
+    struct wlr_surface *surface,
+    double lx,
+    double ly,
+    double sx,
+    double sy,
+    struct wlr_box *box);
+
 void
 hikari_server_stop();
 
@@ -410,6 +426,21 @@ void
 hikari_server_enter_mark_select_switch_mode(void *arg);
 #undef MODE
 
+// normal mode only shows the indicator while the modifier is held, the assign,
+// layout select, move and resize modes always show it.
+static inline bool
+hikari_server_is_indicating(void)
+{
+  if (hikari_server_in_normal_mode()) {
+    return hikari_server.keyboard_state.mod_pressed;
+  }
+
+  return hikari_server_in_group_assign_mode() ||
+         hikari_server_in_layout_select_mode() ||
+         hikari_server_in_mark_assign_mode() || hikari_server_in_move_mode() ||
+         hikari_server_in_resize_mode() || hikari_server_in_sheet_assign_mode();
+}
+
 void
 hikari_server_reset_sheet_layout(void *arg);
 
@@ -425,6 +456,15 @@ hikari_server_layout_sheet(void *arg);
 void
 hikari_server_session_change_vt(void *arg);
 
+void
+hikari_server_toggle_max_fps(void *arg);
+
+void
+hikari_server_screenshot_output(void *arg);
+
+void
+hikari_server_screenshot_view(void *arg);
+
 void
 hikari_server_show_mark(void *arg);
 
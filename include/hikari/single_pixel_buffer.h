@@ -0,0 +1,37 @@
+#if !defined(HIKARI_SINGLE_PIXEL_BUFFER_H)
+#define HIKARI_SINGLE_PIXEL_BUFFER_H
+
+#include <stdint.h>
+
+#include <wayland-server-core.h>
+
+#include <wlr/types/wlr_buffer.h>
+#include <wlr/types/wlr_surface.h>
+
+struct hikari_single_pixel_buffer {
+  struct wlr_buffer buffer;
+  struct wl_resource *resource;
+
+  uint32_t argb8888;
+  float color[4];
+
+  struct wl_listener release;
+};
+
+struct wl_global *
+hikari_single_pixel_buffer_manager_create(struct wl_display *display);
+
+struct hikari_single_pixel_buffer *
+hikari_single_pixel_buffer_from_buffer(struct wlr_buffer *wlr_buffer);
+
+static inline struct hikari_single_pixel_buffer *
+hikari_single_pixel_buffer_from_surface(struct wlr_surface *surface)
+{
+  if (surface->buffer == NULL) {
+    return NULL;
+  }
+
+  return hikari_single_pixel_buffer_from_buffer(surface->buffer->source);
+}
+
+#endif
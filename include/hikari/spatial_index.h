@@ -0,0 +1,64 @@
+#if !defined(HIKARI_SPATIAL_INDEX_H)
+#define HIKARI_SPATIAL_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <wlr/util/box.h>
+
+struct hikari_node;
+struct hikari_output;
+struct hikari_view;
+struct wlr_surface;
+
+struct hikari_spatial_index_entry {
+  struct wlr_box box;
+  struct hikari_view *view;
+};
+
+struct hikari_spatial_index_cell {
+  size_t *entries;
+  size_t nr_entries;
+  size_t capacity;
+};
+
+struct hikari_spatial_index {
+  bool dirty;
+
+  struct hikari_spatial_index_entry *entries;
+  size_t nr_entries;
+  size_t capacity;
+
+  struct hikari_spatial_index_cell *cells;
+  int columns;
+  int rows;
+};
+
+void
+hikari_spatial_index_init(struct hikari_spatial_index *spatial_index);
+
+void
+hikari_spatial_index_fini(struct hikari_spatial_index *spatial_index);
+
+struct hikari_view *
+hikari_spatial_index_view_at(struct hikari_spatial_index *spatial_index,
+    struct hikari_output *output,
+    double ox,
+    double oy,
+    struct wlr_surface **surface,
+    double *sx,
+    double *sy);
+
+bool
+hikari_spatial_index_is_exposed(struct hikari_spatial_index *spatial_index,
+    struct hikari_node *node,
+    struct wlr_surface *surface,
+    struct wlr_box *box);
+
+void
+hikari_spatial_index_invalidate(struct hikari_spatial_index *spatial_index);
+
+unsigned long
+hikari_spatial_index_generation(void);
+
+#endif
@@ -0,0 +1,25 @@
+#if !defined(HIKARI_TRANSACTION_H)
+#define HIKARI_TRANSACTION_H
+
+#include <stdbool.h>
+
+struct hikari_transaction {
+  int depth;
+};
+
+void
+hikari_transaction_init(struct hikari_transaction *transaction);
+
+void
+hikari_transaction_begin(struct hikari_transaction *transaction);
+
+void
+hikari_transaction_commit(struct hikari_transaction *transaction);
+
+static inline bool
+hikari_transaction_is_open(struct hikari_transaction *transaction)
+{
+  return transaction->depth > 0;
+}
+
+#endif
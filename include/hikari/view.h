@@ -61,6 +61,26 @@ struct hikari_view {
 
   struct hikari_operation pending_operation;
 
+  // resize requested while an operation is in flight, newer requests
+  // overwrite older ones.
+  struct {
+    bool pending;
+    int x;
+    int y;
+    int width;
+    int height;
+  } queued_resize;
+
+  uint32_t configure_rtt_msec;
+  uint32_t max_configure_rtt_msec;
+
+  struct {
+    time_t second;
+    unsigned int changes;
+    unsigned int rate;
+    unsigned long total;
+  } title_changes;
+
   struct wlr_box *current_geometry;
   struct wlr_box *current_unmaximized_geometry;
 
@@ -83,6 +103,18 @@ struct hikari_view_child {
 
   struct wlr_surface *surface;
   struct hikari_view *parent;
+  struct hikari_view_child *parent_child;
+
+  // set when the parent child has been destroyed before this child, the
+  // surface is no longer part of the surface tree of the view.
+  bool detached;
+
+  int sx;
+  int sy;
+  int width;
+  int height;
+
+  void (*position)(struct hikari_view_child *, int *, int *);
 
   struct wl_listener commit;
   struct wl_listener new_subsurface;
@@ -91,11 +123,15 @@ struct hikari_view_child {
 void
 hikari_view_child_init(struct hikari_view_child *view_child,
     struct hikari_view *parent,
+    struct hikari_view_child *parent_child,
     struct wlr_surface *surface);
 
 void
 hikari_view_child_fini(struct hikari_view_child *view_child);
 
+void
+hikari_view_child_damage(struct hikari_view_child *view_child, bool whole);
+
 struct hikari_view_subsurface {
   struct hikari_view_child view_child;
 
@@ -107,6 +143,7 @@ struct hikari_view_subsurface {
 void
 hikari_view_subsurface_init(struct hikari_view_subsurface *view_subsurface,
     struct hikari_view *parent,
+    struct hikari_view_child *parent_child,
     struct wlr_subsurface *subsurface);
 
 void
@@ -182,6 +219,9 @@ hikari_view_commit_pending_operation(
 void
 hikari_view_evacuate(struct hikari_view *view, struct hikari_sheet *sheet);
 
+void
+hikari_view_refresh_scale(struct hikari_view *view);
+
 void
 hikari_view_pin_to_sheet(struct hikari_view *view, struct hikari_sheet *sheet);
 
@@ -242,8 +282,10 @@ void
 hikari_view_exchange(struct hikari_view *from, struct hikari_view *to);
 
 void
-hikari_view_damage_surface(
-    struct hikari_view *view, struct wlr_surface *surface, bool whole);
+hikari_view_damage_border(struct hikari_view *view);
+
+void
+hikari_view_damage_content(struct hikari_view *view);
 
 void
 hikari_view_refresh_geometry(
@@ -394,12 +436,4 @@ hikari_view_is_tiling(struct hikari_view *view)
          view->pending_operation.type == HIKARI_OPERATION_TYPE_TILE;
 }
 
-static inline void
-hikari_view_damage_border(struct hikari_view *view)
-{
-  struct wlr_box *geometry = hikari_view_border_geometry(view);
-
-  hikari_output_add_damage(view->output, geometry);
-}
-
 #endif
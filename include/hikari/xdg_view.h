@@ -14,6 +14,9 @@ struct hikari_xdg_view {
 
   struct wlr_xdg_surface *surface;
 
+  int surface_width;
+  int surface_height;
+
   struct wl_listener map;
   struct wl_listener unmap;
   struct wl_listener destroy;
@@ -6,6 +6,9 @@
 #include <hikari/configuration.h>
 #include <hikari/server.h>
 
+#define HIKARI_ACTION_REPEAT_DEFAULT_DELAY 300
+#define HIKARI_ACTION_REPEAT_DEFAULT_RATE 25
+
 static char *
 lookup_action(struct wl_list *action_configs, const char *action_name)
 {
@@ -43,6 +46,15 @@ parse_binding(struct wl_list *action_configs,
   } else if (!strcmp(str, "reload")) {
     *action = hikari_server_reload;
     *arg = NULL;
+  } else if (!strcmp(str, "output-toggle-max-fps")) {
+    *action = hikari_server_toggle_max_fps;
+    *arg = NULL;
+  } else if (!strcmp(str, "screenshot-output")) {
+    *action = hikari_server_screenshot_output;
+    *arg = NULL;
+  } else if (!strcmp(str, "screenshot-view")) {
+    *action = hikari_server_screenshot_view;
+    *arg = NULL;
 #ifndef NDEBUG
   } else if (!strcmp(str, "debug-damage")) {
     *action = hikari_server_toggle_damage_tracking;
@@ -459,6 +471,53 @@ hikari_action_init(struct hikari_action *action)
   action->begin.arg = NULL;
   action->end.action = NULL;
   action->end.arg = NULL;
+  action->repeat.delay = 0;
+  action->repeat.rate = 0;
+  action->repeat.acceleration = 0;
+}
+
+static bool
+parse_repeat(
+    struct hikari_action_repeat *repeat, const ucl_object_t *repeat_obj)
+{
+  bool success = false;
+  const ucl_object_t *cur;
+
+  repeat->delay = HIKARI_ACTION_REPEAT_DEFAULT_DELAY;
+  repeat->rate = HIKARI_ACTION_REPEAT_DEFAULT_RATE;
+  repeat->acceleration = 0;
+
+  ucl_object_iter_t it = ucl_object_iterate_new(repeat_obj);
+  while ((cur = ucl_object_iterate_safe(it, false)) != NULL) {
+    const char *key = ucl_object_key(cur);
+    int64_t value;
+
+    if (!ucl_object_toint_safe(cur, &value) || value < 0) {
+      fprintf(stderr,
+          "configuration error: expected positive integer for \"%s\"\n",
+          key);
+      goto done;
+    }
+
+    if (!strcmp("delay", key)) {
+      repeat->delay = value;
+    } else if (!strcmp("rate", key)) {
+      repeat->rate = value;
+    } else if (!strcmp("acceleration", key)) {
+      repeat->acceleration = value;
+    } else {
+      fprintf(
+          stderr, "configuration error: invalid \"repeat\" key \"%s\"\n", key);
+      goto done;
+    }
+  }
+
+  success = true;
+
+done:
+  ucl_object_iterate_free(it);
+
+  return success;
 }
 
 bool
@@ -472,6 +531,7 @@ hikari_action_parse(struct hikari_action *action,
   if (type == UCL_OBJECT) {
     const ucl_object_t *begin_obj = ucl_object_lookup(action_obj, "begin");
     const ucl_object_t *end_obj = ucl_object_lookup(action_obj, "end");
+    const ucl_object_t *repeat_obj = ucl_object_lookup(action_obj, "repeat");
 
     struct hikari_event_action *begin = &action->begin;
     struct hikari_event_action *end = &action->end;
@@ -489,6 +549,18 @@ hikari_action_parse(struct hikari_action *action,
       }
     }
 
+    if (repeat_obj != NULL) {
+      if (ucl_object_type(repeat_obj) != UCL_OBJECT) {
+        fprintf(stderr,
+            "configuration error: expected object for \"repeat\"\n");
+        goto done;
+      }
+
+      if (!parse_repeat(&action->repeat, repeat_obj)) {
+        goto done;
+      }
+    }
+
   } else if (type == UCL_STRING) {
     struct hikari_event_action *event_action = &action->begin;
 
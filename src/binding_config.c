@@ -70,6 +70,15 @@ hikari_binding_config_key_parse(
       goto done;
     }
 
+    // xkb keycodes are offset by 8 from the input event codes, which never
+    // exceed `KEY_MAX`.
+    if (value < 8 || value - 8 > KEY_MAX) {
+      fprintf(stderr,
+          "configuration error: keycode \"%s\" is out of range\n",
+          remaining + 1);
+      goto done;
+    }
+
     binding_key->type = HIKARI_ACTION_BINDING_KEY_KEYCODE;
     binding_key->value.keycode = (uint32_t)value - 8;
   } else if (*remaining == '+') {
@@ -1,5 +1,6 @@
 #include <hikari/binding_group.h>
 
+#include <linux/input-event-codes.h>
 #include <stdlib.h>
 
 #include <hikari/binding.h>
@@ -11,6 +12,8 @@ hikari_binding_group_init(struct hikari_binding_group *binding_group)
   for (int i = 0; i < HIKARI_BINDING_GROUP_MASK; i++) {
     binding_group[i].nbindings = 0;
     binding_group[i].bindings = NULL;
+    binding_group[i].table_size = 0;
+    binding_group[i].table = NULL;
   }
 }
 
@@ -20,5 +23,53 @@ hikari_binding_group_fini(struct hikari_binding_group *binding_group)
   for (int i = 0; i < HIKARI_BINDING_GROUP_MASK; i++) {
     struct hikari_binding *bindings = binding_group[i].bindings;
     hikari_free(bindings);
+    hikari_free(binding_group[i].table);
+  }
+}
+
+static void
+index_bindings(struct hikari_binding_group *binding_group)
+{
+  int nbindings = binding_group->nbindings;
+  struct hikari_binding *bindings = binding_group->bindings;
+  uint32_t table_size = 0;
+
+  for (int i = 0; i < nbindings; i++) {
+    uint32_t keycode = bindings[i].keycode;
+
+    // input events never carry codes beyond `KEY_MAX`, configured keycodes
+    // are range checked while parsing and keysyms only resolve to keys
+    // with an input event code.
+    if (keycode <= KEY_MAX && keycode >= table_size) {
+      table_size = keycode + 1;
+    }
+  }
+
+  binding_group->table_size = table_size;
+
+  if (table_size == 0) {
+    binding_group->table = NULL;
+    return;
+  }
+
+  binding_group->table =
+      hikari_calloc(table_size, sizeof(struct hikari_binding *));
+
+  for (int i = 0; i < nbindings; i++) {
+    struct hikari_binding *binding = &bindings[i];
+    uint32_t keycode = binding->keycode;
+
+    // the first binding for a keycode takes precedence.
+    if (keycode < table_size && binding_group->table[keycode] == NULL) {
+      binding_group->table[keycode] = binding;
+    }
+  }
+}
+
+void
+hikari_binding_group_index(struct hikari_binding_group *binding_group)
+{
+  for (int i = 0; i < HIKARI_BINDING_GROUP_MASK; i++) {
+    index_bindings(&binding_group[i]);
   }
 }
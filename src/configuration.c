@@ -1427,6 +1427,26 @@ parse_output_config(struct hikari_output_config *output_config,
       }
 
       hikari_output_config_set_position(output_config, position);
+    } else if (!strcmp(key, "scale")) {
+      double scale;
+      if (!ucl_object_todouble_safe(cur, &scale) || scale <= 0) {
+        fprintf(stderr,
+            "configuration error: expected positive float for \"output\" "
+            "\"scale\"\n");
+        goto done;
+      }
+
+      hikari_output_config_set_scale(output_config, scale);
+    } else if (!strcmp(key, "max-fps")) {
+      int64_t max_fps;
+      if (!ucl_object_toint_safe(cur, &max_fps) || max_fps < 0) {
+        fprintf(stderr,
+            "configuration error: expected non-negative integer for "
+            "\"output\" \"max-fps\"\n");
+        goto done;
+      }
+
+      hikari_output_config_set_max_fps(output_config, max_fps);
     } else {
       fprintf(stderr,
           "configuration error: unknown \"outputs\" configuration key \"%s\"\n",
@@ -1550,6 +1570,24 @@ parse_font(
   return true;
 }
 
+static bool
+parse_screenshot_directory(struct hikari_configuration *configuration,
+    const ucl_object_t *screenshot_directory_obj)
+{
+  char *screenshot_directory = copy_in_config_string(screenshot_directory_obj);
+
+  if (screenshot_directory == NULL) {
+    fprintf(stderr,
+        "configuration error: expected string for \"screenshot-directory\"\n");
+    return false;
+  }
+
+  hikari_free(configuration->screenshot_directory);
+  configuration->screenshot_directory = screenshot_directory;
+
+  return true;
+}
+
 static bool
 parse_ui(struct hikari_configuration *configuration, const ucl_object_t *ui_obj)
 {
@@ -1581,6 +1619,10 @@ parse_ui(struct hikari_configuration *configuration, const ucl_object_t *ui_obj)
       if (!parse_step(configuration, cur)) {
         goto done;
       }
+    } else if (!strcmp(key, "screenshot-directory")) {
+      if (!parse_screenshot_directory(configuration, cur)) {
+        goto done;
+      }
     }
   }
 
@@ -1719,6 +1761,10 @@ hikari_configuration_reload(char *config_path)
           &hikari_server.indicator, hikari_server.workspace->focus_view);
     }
 
+    // repeated actions can refer to the configuration that is about to be
+    // freed.
+    hikari_normal_mode_stop_repeat(&hikari_server.normal_mode);
+
     hikari_configuration_fini(hikari_configuration);
     hikari_free(hikari_configuration);
     hikari_configuration = configuration;
@@ -1772,6 +1818,14 @@ hikari_configuration_reload(char *config_path)
           }
         }
 
+        hikari_output_set_max_fps(output, output_config->max_fps.value);
+
+        // wlr_output stores the scale as a float.
+        float scale = output_config->scale.value;
+        if (scale != output->wlr_output->scale) {
+          hikari_output_set_scale(output, output_config->scale.value);
+        }
+
         if (output_config->background.value != NULL) {
           hikari_output_load_background(output,
               output_config->background.value,
@@ -1802,6 +1856,8 @@ hikari_configuration_reload(char *config_path)
     hikari_free(configuration);
   }
 
+  hikari_keymaps_prune(&hikari_configuration->keyboard_configs);
+
   return success;
 }
 
@@ -1834,6 +1890,8 @@ hikari_configuration_init(struct hikari_configuration *configuration)
   configuration->gap = 5;
   configuration->step = 100;
 
+  configuration->screenshot_directory = NULL;
+
   for (int i = 0; i < HIKARI_NR_OF_EXECS; i++) {
     hikari_exec_init(&configuration->execs[i]);
   }
@@ -1860,6 +1918,8 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
     hikari_free(output_config);
   }
 
+  hikari_free(configuration->screenshot_directory);
+
   struct hikari_pointer_config *pointer_config, *pointer_config_temp;
   wl_list_for_each_safe (pointer_config,
       pointer_config_temp,
@@ -8,6 +8,7 @@
 
 #include <hikari/binding.h>
 #include <hikari/binding_config.h>
+#include <hikari/latency.h>
 #include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
@@ -105,6 +106,8 @@ configure_bindings(struct hikari_cursor *cursor, struct wl_list *bindings)
 
     nr[mask]++;
   }
+
+  hikari_binding_group_index(cursor->bindings);
 }
 
 void
@@ -122,6 +125,9 @@ hikari_cursor_init(
   wlr_xcursor_manager_load(cursor->cursor_mgr, 1);
 
   cursor->wlr_cursor = wlr_cursor;
+  cursor->motion_idle = NULL;
+  cursor->motion_time_msec = 0;
+  cursor->frame_pending = false;
 
   wl_list_init(&cursor->surface_destroy.link);
   hikari_binding_group_init(cursor->bindings);
@@ -182,6 +188,12 @@ hikari_cursor_deactivate(struct hikari_cursor *cursor)
   wl_list_remove(&cursor->axis.link);
   wl_list_remove(&cursor->request_set_cursor.link);
 
+  if (cursor->motion_idle != NULL) {
+    wl_event_source_remove(cursor->motion_idle);
+    cursor->motion_idle = NULL;
+  }
+  cursor->frame_pending = false;
+
   hikari_cursor_set_image(cursor, NULL);
 }
 
@@ -210,6 +222,44 @@ hikari_cursor_center(struct hikari_cursor *cursor,
   hikari_cursor_warp(cursor, x, y);
 }
 
+static void
+motion_idle_handler(void *data)
+{
+  struct hikari_cursor *cursor = data;
+
+  cursor->motion_idle = NULL;
+
+  hikari_server.mode->cursor_move(cursor->motion_time_msec);
+
+  if (cursor->frame_pending) {
+    cursor->frame_pending = false;
+    wlr_seat_pointer_notify_frame(hikari_server.seat);
+  }
+}
+
+static void
+queue_motion(struct hikari_cursor *cursor, uint32_t time_msec)
+{
+  cursor->motion_time_msec = time_msec;
+  hikari_latency_input(HIKARI_LATENCY_EVENT_MOTION, time_msec);
+
+  // the cursor position is updated for every event but the mode only handles
+  // the accumulated motion once all pending input events have been read.
+  if (cursor->motion_idle == NULL) {
+    cursor->motion_idle = wl_event_loop_add_idle(
+        hikari_server.event_loop, motion_idle_handler, cursor);
+  }
+}
+
+void
+hikari_cursor_flush_motion(struct hikari_cursor *cursor)
+{
+  if (cursor->motion_idle != NULL) {
+    wl_event_source_remove(cursor->motion_idle);
+    motion_idle_handler(cursor);
+  }
+}
+
 static void
 motion_absolute_handler(struct wl_listener *listener, void *data)
 {
@@ -223,15 +273,21 @@ motion_absolute_handler(struct wl_listener *listener, void *data)
   wlr_cursor_warp_absolute(
       cursor->wlr_cursor, event->device, event->x, event->y);
 
-  hikari_server.mode->cursor_move(event->time_msec);
+  queue_motion(cursor, event->time_msec);
 }
 
 static void
 frame_handler(struct wl_listener *listener, void *data)
 {
+  struct hikari_cursor *cursor = wl_container_of(listener, cursor, frame);
+
   assert(!hikari_server_in_lock_mode());
 
-  wlr_seat_pointer_notify_frame(hikari_server.seat);
+  if (cursor->motion_idle != NULL) {
+    cursor->frame_pending = true;
+  } else {
+    wlr_seat_pointer_notify_frame(hikari_server.seat);
+  }
 }
 
 static void
@@ -246,7 +302,7 @@ motion_handler(struct wl_listener *listener, void *data)
   wlr_cursor_move(
       cursor->wlr_cursor, event->device, event->delta_x, event->delta_y);
 
-  hikari_server.mode->cursor_move(event->time_msec);
+  queue_motion(cursor, event->time_msec);
 }
 
 static void
@@ -257,6 +313,9 @@ button_handler(struct wl_listener *listener, void *data)
   struct hikari_cursor *cursor = wl_container_of(listener, cursor, button);
   struct wlr_event_pointer_button *event = data;
 
+  hikari_cursor_flush_motion(cursor);
+
+  hikari_latency_input(HIKARI_LATENCY_EVENT_BUTTON, event->time_msec);
   hikari_server.mode->button_handler(cursor, event);
 }
 
@@ -265,8 +324,11 @@ axis_handler(struct wl_listener *listener, void *data)
 {
   assert(!hikari_server_in_lock_mode());
 
+  struct hikari_cursor *cursor = wl_container_of(listener, cursor, axis);
   struct wlr_event_pointer_axis *event = data;
 
+  hikari_cursor_flush_motion(cursor);
+
   wlr_seat_pointer_notify_axis(hikari_server.seat,
       event->time_msec,
       event->orientation,
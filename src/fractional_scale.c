@@ -0,0 +1,282 @@
+#include <hikari/fractional_scale.h>
+
+#include <assert.h>
+#include <math.h>
+
+#include <wlr/types/wlr_output_layout.h>
+#include <wlr/types/wlr_xdg_shell.h>
+
+#ifdef HAVE_LAYERSHELL
+#include <wlr/types/wlr_layer_shell_v1.h>
+#endif
+
+#ifdef HAVE_XWAYLAND
+#include <wlr/xwayland.h>
+#endif
+
+#include <hikari/memory.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+#include <hikari/xdg_view.h>
+
+#include "fractional-scale-v1-protocol.h"
+
+#define FRACTIONAL_SCALE_MANAGER_VERSION 1
+
+// the protocol transports scales as multiples of 1/120.
+#define FRACTIONAL_SCALE_DENOMINATOR 120
+
+struct hikari_fractional_scale {
+  struct wl_list link;
+
+  struct wl_resource *resource;
+  struct wlr_surface *surface;
+
+  uint32_t scale;
+
+  struct wl_listener surface_destroy;
+};
+
+static struct wl_list fractional_scales;
+
+static const struct wp_fractional_scale_v1_interface fractional_scale_impl;
+
+static struct hikari_fractional_scale *
+fractional_scale_from_resource(struct wl_resource *resource)
+{
+  assert(wl_resource_instance_of(
+      resource, &wp_fractional_scale_v1_interface, &fractional_scale_impl));
+
+  return wl_resource_get_user_data(resource);
+}
+
+static struct hikari_fractional_scale *
+fractional_scale_from_surface(struct wlr_surface *surface)
+{
+  struct hikari_fractional_scale *fractional_scale;
+  wl_list_for_each (fractional_scale, &fractional_scales, link) {
+    if (fractional_scale->surface == surface) {
+      return fractional_scale;
+    }
+  }
+
+  return NULL;
+}
+
+static void
+fractional_scale_destroy(struct hikari_fractional_scale *fractional_scale)
+{
+  if (fractional_scale == NULL) {
+    return;
+  }
+
+  wl_list_remove(&fractional_scale->link);
+  wl_list_remove(&fractional_scale->surface_destroy.link);
+  wl_resource_set_user_data(fractional_scale->resource, NULL);
+
+  hikari_free(fractional_scale);
+}
+
+static void
+send_scale(struct hikari_fractional_scale *fractional_scale, double scale)
+{
+  uint32_t wire_scale = round(scale * FRACTIONAL_SCALE_DENOMINATOR);
+
+  if (fractional_scale->scale == wire_scale) {
+    return;
+  }
+
+  fractional_scale->scale = wire_scale;
+  wp_fractional_scale_v1_send_preferred_scale(
+      fractional_scale->resource, wire_scale);
+}
+
+void
+hikari_fractional_scale_notify(struct wlr_surface *surface, double scale)
+{
+  assert(surface != NULL);
+
+  struct hikari_fractional_scale *fractional_scale =
+      fractional_scale_from_surface(surface);
+
+  if (fractional_scale != NULL) {
+    send_scale(fractional_scale, scale);
+  }
+}
+
+static void
+fractional_scale_handle_destroy(
+    struct wl_client *client, struct wl_resource *resource)
+{
+  wl_resource_destroy(resource);
+}
+
+static const struct wp_fractional_scale_v1_interface fractional_scale_impl = {
+  .destroy = fractional_scale_handle_destroy,
+};
+
+static void
+resource_destroy_handler(struct wl_resource *resource)
+{
+  fractional_scale_destroy(fractional_scale_from_resource(resource));
+}
+
+static void
+surface_destroy_handler(struct wl_listener *listener, void *data)
+{
+  struct hikari_fractional_scale *fractional_scale =
+      wl_container_of(listener, fractional_scale, surface_destroy);
+
+  fractional_scale_destroy(fractional_scale);
+}
+
+static void
+manager_handle_destroy(struct wl_client *client, struct wl_resource *resource)
+{
+  wl_resource_destroy(resource);
+}
+
+// resolves the output a surface is shown on through the node that owns it,
+// subsurfaces belong to their root surface and popups to their parent.
+static struct hikari_output *
+surface_output(struct wlr_surface *surface)
+{
+  for (;;) {
+    surface = wlr_surface_get_root_surface(surface);
+
+    if (wlr_surface_is_xdg_surface(surface)) {
+      struct wlr_xdg_surface *xdg_surface =
+          wlr_xdg_surface_from_wlr_surface(surface);
+
+      if (xdg_surface->role == WLR_XDG_SURFACE_ROLE_POPUP &&
+          xdg_surface->popup->parent != NULL) {
+        surface = xdg_surface->popup->parent;
+        continue;
+      }
+
+      if (xdg_surface->role == WLR_XDG_SURFACE_ROLE_TOPLEVEL &&
+          xdg_surface->data != NULL) {
+        struct hikari_xdg_view *xdg_view = xdg_surface->data;
+        return xdg_view->view.output;
+      }
+
+      return NULL;
+    }
+
+#ifdef HAVE_LAYERSHELL
+    if (wlr_surface_is_layer_surface(surface)) {
+      struct wlr_layer_surface_v1 *layer_surface =
+          wlr_layer_surface_v1_from_wlr_surface(surface);
+
+      return layer_surface->output != NULL ? layer_surface->output->data
+                                           : NULL;
+    }
+#endif
+
+#ifdef HAVE_XWAYLAND
+    if (wlr_surface_is_xwayland_surface(surface)) {
+      struct wlr_xwayland_surface *xwayland_surface =
+          wlr_xwayland_surface_from_wlr_surface(surface);
+
+      struct wlr_output *wlr_output =
+          wlr_output_layout_output_at(hikari_server.output_layout,
+              xwayland_surface->x + xwayland_surface->width / 2.0,
+              xwayland_surface->y + xwayland_surface->height / 2.0);
+
+      return wlr_output != NULL ? wlr_output->data : NULL;
+    }
+#endif
+
+    return NULL;
+  }
+}
+
+static void
+manager_handle_get_fractional_scale(struct wl_client *client,
+    struct wl_resource *manager_resource,
+    uint32_t id,
+    struct wl_resource *surface_resource)
+{
+  struct wlr_surface *surface = wlr_surface_from_resource(surface_resource);
+
+  if (fractional_scale_from_surface(surface) != NULL) {
+    wl_resource_post_error(manager_resource,
+        WP_FRACTIONAL_SCALE_MANAGER_V1_ERROR_FRACTIONAL_SCALE_EXISTS,
+        "a wp_fractional_scale_v1 object already exists for this surface");
+    return;
+  }
+
+  struct hikari_fractional_scale *fractional_scale =
+      hikari_malloc(sizeof(struct hikari_fractional_scale));
+
+  if (fractional_scale == NULL) {
+    wl_client_post_no_memory(client);
+    return;
+  }
+
+  fractional_scale->resource = wl_resource_create(client,
+      &wp_fractional_scale_v1_interface,
+      wl_resource_get_version(manager_resource),
+      id);
+
+  if (fractional_scale->resource == NULL) {
+    wl_client_post_no_memory(client);
+    hikari_free(fractional_scale);
+    return;
+  }
+
+  wl_resource_set_implementation(fractional_scale->resource,
+      &fractional_scale_impl,
+      fractional_scale,
+      resource_destroy_handler);
+
+  fractional_scale->surface = surface;
+  fractional_scale->scale = 0;
+
+  fractional_scale->surface_destroy.notify = surface_destroy_handler;
+  wl_signal_add(&surface->events.destroy, &fractional_scale->surface_destroy);
+
+  wl_list_insert(&fractional_scales, &fractional_scale->link);
+
+  // surfaces without a known output yet get the scale of the focused output,
+  // they are corrected when their view is configured or when they map.
+  struct hikari_output *output = surface_output(surface);
+
+  if (output == NULL) {
+    output = hikari_server.workspace->output;
+  }
+
+  send_scale(fractional_scale, output->wlr_output->scale);
+}
+
+static const struct wp_fractional_scale_manager_v1_interface manager_impl = {
+  .destroy = manager_handle_destroy,
+  .get_fractional_scale = manager_handle_get_fractional_scale,
+};
+
+static void
+manager_bind(
+    struct wl_client *client, void *data, uint32_t version, uint32_t id)
+{
+  struct wl_resource *resource = wl_resource_create(
+      client, &wp_fractional_scale_manager_v1_interface, version, id);
+
+  if (resource == NULL) {
+    wl_client_post_no_memory(client);
+    return;
+  }
+
+  wl_resource_set_implementation(resource, &manager_impl, NULL, NULL);
+}
+
+struct wl_global *
+hikari_fractional_scale_manager_create(struct wl_display *display)
+{
+  wl_list_init(&fractional_scales);
+
+  return wl_global_create(display,
+      &wp_fractional_scale_manager_v1_interface,
+      FRACTIONAL_SCALE_MANAGER_VERSION,
+      NULL,
+      manager_bind);
+}
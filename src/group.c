@@ -5,6 +5,8 @@
 #include <string.h>
 
 #include <hikari/memory.h>
+#include <hikari/server.h>
+#include <hikari/transaction.h>
 #include <hikari/view.h>
 
 void
@@ -51,6 +53,8 @@ hikari_group_raise(struct hikari_group *group, struct hikari_view *top)
   assert(group != NULL);
   assert(top != NULL);
 
+  hikari_transaction_begin(&hikari_server.transaction);
+
   hikari_view_raise(top);
 
   struct hikari_view *view, *view_temp;
@@ -66,6 +70,8 @@ hikari_group_raise(struct hikari_group *group, struct hikari_view *top)
   }
 
   hikari_view_raise(top);
+
+  hikari_transaction_commit(&hikari_server.transaction);
 }
 
 void
@@ -74,6 +80,8 @@ hikari_group_lower(struct hikari_group *group, struct hikari_view *top)
   assert(group != NULL);
   assert(top != NULL);
 
+  hikari_transaction_begin(&hikari_server.transaction);
+
   hikari_view_lower(top);
 
   struct hikari_view *view, *view_temp;
@@ -87,6 +95,8 @@ hikari_group_lower(struct hikari_group *group, struct hikari_view *top)
       break;
     }
   }
+
+  hikari_transaction_commit(&hikari_server.transaction);
 }
 
 void
@@ -101,6 +111,8 @@ hikari_group_damage(struct hikari_group *group)
 void
 hikari_group_show(struct hikari_group *group)
 {
+  hikari_transaction_begin(&hikari_server.transaction);
+
   struct hikari_view *view, *view_temp;
   wl_list_for_each_reverse_safe (view, view_temp, &group->views, group_views) {
     if (hikari_view_is_hidden(view)) {
@@ -109,14 +121,20 @@ hikari_group_show(struct hikari_group *group)
       break;
     }
   }
+
+  hikari_transaction_commit(&hikari_server.transaction);
 }
 
 void
 hikari_group_hide(struct hikari_group *group)
 {
+  hikari_transaction_begin(&hikari_server.transaction);
+
   struct hikari_view *view, *view_temp;
   wl_list_for_each_safe (
       view, view_temp, &group->visible_views, visible_group_views) {
     hikari_view_hide(view);
   }
+
+  hikari_transaction_commit(&hikari_server.transaction);
 }
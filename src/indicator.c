@@ -22,6 +22,9 @@ hikari_indicator_init(struct hikari_indicator *indicator, float color[static 4])
   hikari_indicator_bar_init(&indicator->group, indicator, offset, color);
   offset += bar_height + 5;
   hikari_indicator_bar_init(&indicator->mark, indicator, offset, color);
+
+  indicator->stale = false;
+  indicator->title_pending = false;
 }
 
 void
@@ -50,6 +53,39 @@ hikari_indicator_update(
   } else {
     hikari_indicator_update_mark(indicator, output, "");
   }
+
+  indicator->stale = false;
+  indicator->title_pending = false;
+}
+
+void
+hikari_indicator_refresh(
+    struct hikari_indicator *indicator, struct hikari_view *view)
+{
+  if (indicator->stale) {
+    hikari_indicator_update(indicator, view);
+  }
+}
+
+void
+hikari_indicator_commit_title(
+    struct hikari_indicator *indicator, struct hikari_output *output)
+{
+  struct hikari_view *focus_view = hikari_server.workspace->focus_view;
+
+  if (!indicator->title_pending || focus_view == NULL ||
+      focus_view->output != output) {
+    return;
+  }
+
+  indicator->title_pending = false;
+
+  struct wlr_box *geometry = hikari_view_border_geometry(focus_view);
+
+  // the width of the bar depends on the title.
+  hikari_indicator_damage_title(indicator, output, geometry);
+  hikari_indicator_update_title(indicator, output, focus_view->title);
+  hikari_indicator_damage_title(indicator, output, geometry);
 }
 
 void
@@ -77,6 +77,10 @@ hikari_indicator_bar_update(struct hikari_indicator_bar *indicator_bar,
 
   size_t len = strlen(text);
 
+#ifndef NDEBUG
+  hikari_server.statistics.indicator_rasterizations++;
+#endif
+
   struct hikari_font *font = &hikari_configuration->font;
   int width = hikari_configuration->font.character_width * len + 8;
   int height = hikari_configuration->font.height;
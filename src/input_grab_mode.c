@@ -29,20 +29,15 @@ modifiers_handler(struct hikari_keyboard *keyboard)
 static bool
 handle_input(struct hikari_binding_group *map, uint32_t code)
 {
-  int nbindings = map->nbindings;
-  struct hikari_binding *bindings = map->bindings;
+  struct hikari_binding *binding = hikari_binding_group_find(map, code);
 
-  for (int i = 0; i < nbindings; i++) {
-    struct hikari_binding *binding = &bindings[i];
-
-    if (binding->keycode == code) {
-      struct hikari_event_action *event_action = &binding->action->begin;
-
-      return event_action->action == hikari_server_enter_input_grab_mode;
-    }
+  if (binding == NULL) {
+    return false;
   }
 
-  return false;
+  struct hikari_event_action *event_action = &binding->action->begin;
+
+  return event_action->action == hikari_server_enter_input_grab_mode;
 }
 
 static void
@@ -62,7 +57,7 @@ key_handler(
     }
   }
 
-  wlr_seat_set_keyboard(hikari_server.seat, keyboard->device);
+  hikari_keyboard_activate(keyboard);
   wlr_seat_keyboard_notify_key(
       hikari_server.seat, event->time_msec, event->keycode, event->state);
 }
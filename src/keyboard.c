@@ -1,5 +1,9 @@
 #include <hikari/keyboard.h>
 
+#include <linux/input-event-codes.h>
+#include <stdlib.h>
+#include <time.h>
+
 #include <wlr/types/wlr_input_device.h>
 #include <wlr/types/wlr_keyboard.h>
 #include <wlr/types/wlr_seat.h>
@@ -7,6 +11,8 @@
 #include <hikari/binding.h>
 #include <hikari/binding_config.h>
 #include <hikari/keyboard_config.h>
+#include <hikari/keyboard_group.h>
+#include <hikari/latency.h>
 #include <hikari/memory.h>
 #include <hikari/mode.h>
 #include <hikari/server.h>
@@ -32,6 +38,11 @@ key_handler(struct wl_listener *listener, void *data)
   struct hikari_keyboard *keyboard = wl_container_of(listener, keyboard, key);
   struct wlr_event_keyboard_key *event = data;
 
+  // bindings act on the pointer focus, which has to reflect all motion that
+  // arrived before the key.
+  hikari_cursor_flush_motion(&hikari_server.cursor);
+
+  hikari_latency_input(HIKARI_LATENCY_EVENT_KEY, event->time_msec);
   hikari_server.mode->key_handler(keyboard, event);
 }
 
@@ -59,36 +70,116 @@ destroy_handler(struct wl_listener *listener, void *data)
   /* wlr_seat_set_capabilities(hikari_server.seat, caps); */
 }
 
-struct keycode_matcher_state {
-  xkb_keysym_t keysym;
-  uint32_t *keycode;
+struct keysym_index_state {
   struct xkb_state *state;
+  size_t nkeysyms;
+  size_t capacity;
+  struct hikari_keysym_entry *keysyms;
 };
 
 static void
-match_keycode(struct xkb_keymap *keymap, xkb_keycode_t key, void *data)
+index_keycode(struct xkb_keymap *keymap, xkb_keycode_t key, void *data)
+{
+  struct keysym_index_state *index_state = data;
+
+  // keys without an input event code can never trigger a binding, keysyms
+  // resolve to the next key that produces them.
+  if (key < 8 || key - 8 > KEY_MAX) {
+    return;
+  }
+
+  xkb_keysym_t keysym = xkb_state_key_get_one_sym(index_state->state, key);
+
+  if (keysym == XKB_KEY_NoSymbol) {
+    return;
+  }
+
+  if (index_state->nkeysyms == index_state->capacity) {
+    index_state->capacity =
+        index_state->capacity == 0 ? 256 : index_state->capacity * 2;
+    index_state->keysyms = hikari_realloc(index_state->keysyms,
+        index_state->capacity * sizeof(struct hikari_keysym_entry));
+  }
+
+  struct hikari_keysym_entry *entry =
+      &index_state->keysyms[index_state->nkeysyms++];
+
+  entry->keysym = keysym;
+  entry->keycode = key - 8;
+}
+
+static int
+compare_keysym_entries(const void *a, const void *b)
 {
-  struct keycode_matcher_state *matcher_state = data;
-  xkb_keysym_t keysym = xkb_state_key_get_one_sym(matcher_state->state, key);
+  const struct hikari_keysym_entry *entry_a = a;
+  const struct hikari_keysym_entry *entry_b = b;
+
+  if (entry_a->keysym != entry_b->keysym) {
+    return entry_a->keysym < entry_b->keysym ? -1 : 1;
+  }
 
-  if (keysym != XKB_KEY_NoSymbol && keysym == matcher_state->keysym &&
-      *(matcher_state->keycode) == 0) {
-    *(matcher_state->keycode) = key - 8;
+  if (entry_a->keycode != entry_b->keycode) {
+    return entry_a->keycode < entry_b->keycode ? -1 : 1;
   }
+
+  return 0;
+}
+
+static void
+index_keysyms(struct hikari_keyboard *keyboard)
+{
+  struct keysym_index_state index_state = {
+    .state = xkb_state_new(keyboard->keymap),
+    .nkeysyms = 0,
+    .capacity = 0,
+    .keysyms = NULL,
+  };
+
+  xkb_keymap_key_for_each(keyboard->keymap, index_keycode, &index_state);
+  xkb_state_unref(index_state.state);
+
+  qsort(index_state.keysyms,
+      index_state.nkeysyms,
+      sizeof(struct hikari_keysym_entry),
+      compare_keysym_entries);
+
+  hikari_free(keyboard->keysyms);
+  keyboard->keysyms = index_state.keysyms;
+  keyboard->nkeysyms = index_state.nkeysyms;
 }
 
 static void
-resolve_keysym(uint32_t *keycode, struct xkb_state *state, xkb_keysym_t keysym)
+resolve_keysym(
+    uint32_t *keycode, struct hikari_keyboard *keyboard, xkb_keysym_t keysym)
 {
-  struct keycode_matcher_state matcher_state = { keysym, keycode, state };
+  size_t lower = 0;
+  size_t upper = keyboard->nkeysyms;
+
+  // find the first entry for the keysym, entries with equal keysyms are
+  // ordered by keycode and the lowest keycode takes precedence.
+  while (lower < upper) {
+    size_t middle = lower + (upper - lower) / 2;
+
+    if (keyboard->keysyms[middle].keysym < keysym) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
 
-  xkb_keymap_key_for_each(
-      xkb_state_get_keymap(state), match_keycode, &matcher_state);
+  if (lower < keyboard->nkeysyms && keyboard->keysyms[lower].keysym == keysym) {
+    *keycode = keyboard->keysyms[lower].keycode;
+  }
 }
 
 static void
 configure_bindings(struct hikari_keyboard *keyboard, struct wl_list *bindings)
 {
+#ifndef NDEBUG
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+#endif
+
   int nr[256] = { 0 };
   struct hikari_binding_config *binding_config;
   wl_list_for_each (binding_config, bindings, link) {
@@ -107,8 +198,6 @@ configure_bindings(struct hikari_keyboard *keyboard, struct wl_list *bindings)
     nr[mask] = 0;
   }
 
-  struct xkb_state *state = xkb_state_new(keyboard->keymap);
-
   wl_list_for_each (binding_config, bindings, link) {
     uint8_t mask = binding_config->key.modifiers;
     struct hikari_binding *binding =
@@ -123,14 +212,22 @@ configure_bindings(struct hikari_keyboard *keyboard, struct wl_list *bindings)
 
       case HIKARI_ACTION_BINDING_KEY_KEYSYM:
         resolve_keysym(
-            &binding->keycode, state, binding_config->key.value.keysym);
+            &binding->keycode, keyboard, binding_config->key.value.keysym);
         break;
     }
 
     nr[mask]++;
   }
 
-  xkb_state_unref(state);
+  hikari_binding_group_index(keyboard->bindings);
+
+#ifndef NDEBUG
+  struct timespec end;
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  keyboard->binding_resolution_usec = (end.tv_sec - start.tv_sec) * 1000000 +
+                                      (end.tv_nsec - start.tv_nsec) / 1000;
+#endif
 }
 
 void
@@ -139,6 +236,12 @@ hikari_keyboard_init(
 {
   keyboard->device = device;
   keyboard->keymap = NULL;
+  keyboard->group = NULL;
+  keyboard->nkeysyms = 0;
+  keyboard->keysyms = NULL;
+#ifndef NDEBUG
+  keyboard->binding_resolution_usec = 0;
+#endif
 
   keyboard->modifiers.notify = modifiers_handler;
   wl_signal_add(&device->keyboard->events.modifiers, &keyboard->modifiers);
@@ -165,7 +268,10 @@ hikari_keyboard_fini(struct hikari_keyboard *keyboard)
 
   wl_list_remove(&keyboard->server_keyboards);
 
+  hikari_keyboard_group_leave(keyboard);
+
   xkb_keymap_unref(keyboard->keymap);
+  hikari_free(keyboard->keysyms);
   hikari_binding_group_fini(keyboard->bindings);
 }
 
@@ -189,15 +295,50 @@ void
 hikari_keyboard_configure(struct hikari_keyboard *keyboard,
     struct hikari_keyboard_config *keyboard_config)
 {
-  keyboard->keymap = load_keymap(keyboard_config);
-  assert(keyboard->keymap != NULL);
-  wlr_keyboard_set_keymap(keyboard->device->keyboard, keyboard->keymap);
+  struct xkb_keymap *keymap = load_keymap(keyboard_config);
+  assert(keymap != NULL);
 
   int repeat_rate = hikari_keyboard_config_get_repeat_rate(keyboard_config);
   int repeat_delay = hikari_keyboard_config_get_repeat_delay(keyboard_config);
 
-  wlr_keyboard_set_repeat_info(
-      keyboard->device->keyboard, repeat_rate, repeat_delay);
+  // changing the keymap of a grouped device would change it for the whole
+  // group.
+  if (keyboard->group != NULL &&
+      !hikari_keyboard_group_matches(
+          keyboard->group, keymap, repeat_rate, repeat_delay)) {
+    hikari_keyboard_group_leave(keyboard);
+  }
+
+  if (keymap != keyboard->keymap) {
+    xkb_keymap_unref(keyboard->keymap);
+    keyboard->keymap = keymap;
+
+    wlr_keyboard_set_keymap(keyboard->device->keyboard, keyboard->keymap);
+
+    // only index keysyms once per compiled keymap.
+    index_keysyms(keyboard);
+  } else {
+    xkb_keymap_unref(keymap);
+  }
+
+  if (keyboard->group == NULL) {
+    wlr_keyboard_set_repeat_info(
+        keyboard->device->keyboard, repeat_rate, repeat_delay);
+
+    hikari_keyboard_group_join(keyboard);
+  }
+}
+
+void
+hikari_keyboard_activate(struct hikari_keyboard *keyboard)
+{
+  struct wlr_input_device *device = keyboard->device;
+
+  if (keyboard->group != NULL) {
+    device = keyboard->group->wlr_keyboard_group->input_device;
+  }
+
+  wlr_seat_set_keyboard(hikari_server.seat, device);
 }
 
 void
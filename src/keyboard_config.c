@@ -4,9 +4,38 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <hikari/memory.h>
+
 #define HIKARI_KEYBOARD_CONFIG_DEFAULT_REPEAT_RATE 25
 #define HIKARI_KEYBOARD_CONFIG_DEFAULT_REPEAT_DELAY 600
 
+struct keymap_cache_entry {
+  struct wl_list link;
+
+  char *rules;
+  char *model;
+  char *layout;
+  char *variant;
+  char *options;
+
+  struct xkb_keymap *keymap;
+};
+
+// creating a context scans the xkb include paths and compiling a keymap from
+// rules is expensive, both are shared by all keyboards and reloads.
+static struct xkb_context *context = NULL;
+static struct wl_list keymap_cache = { &keymap_cache, &keymap_cache };
+
+static struct xkb_context *
+get_context(void)
+{
+  if (context == NULL) {
+    context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+  }
+
+  return context;
+}
+
 static void
 init_default_repeat(struct hikari_keyboard_config *keyboard_config)
 {
@@ -98,12 +127,10 @@ load_xkb_file(struct hikari_xkb *xkb, const char *xkb_file)
     goto done;
   }
 
-  struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-  struct xkb_keymap *keymap = xkb_keymap_new_from_file(context,
+  struct xkb_keymap *keymap = xkb_keymap_new_from_file(get_context(),
       keymap_file,
       XKB_KEYMAP_FORMAT_TEXT_V1,
       XKB_KEYMAP_COMPILE_NO_FLAGS);
-  xkb_context_unref(context);
 
   if (keymap == NULL) {
     goto done;
@@ -338,6 +365,55 @@ hikari_keyboard_config_merge(struct hikari_keyboard_config *keyboard_config,
 }
 #undef MERGE
 
+static bool
+option_equals(const char *a, const char *b)
+{
+  if (a == NULL || b == NULL) {
+    return a == b;
+  }
+
+  return !strcmp(a, b);
+}
+
+static char *
+option_dup(const char *option)
+{
+  return option != NULL ? strdup(option) : NULL;
+}
+
+static struct keymap_cache_entry *
+find_cached_keymap(struct xkb_rule_names *rules)
+{
+  struct keymap_cache_entry *entry;
+  wl_list_for_each (entry, &keymap_cache, link) {
+    if (option_equals(entry->rules, rules->rules) &&
+        option_equals(entry->model, rules->model) &&
+        option_equals(entry->layout, rules->layout) &&
+        option_equals(entry->variant, rules->variant) &&
+        option_equals(entry->options, rules->options)) {
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+static void
+cache_keymap(struct xkb_rule_names *rules, struct xkb_keymap *keymap)
+{
+  struct keymap_cache_entry *entry =
+      hikari_malloc(sizeof(struct keymap_cache_entry));
+
+  entry->rules = option_dup(rules->rules);
+  entry->model = option_dup(rules->model);
+  entry->layout = option_dup(rules->layout);
+  entry->variant = option_dup(rules->variant);
+  entry->options = option_dup(rules->options);
+  entry->keymap = xkb_keymap_ref(keymap);
+
+  wl_list_insert(&keymap_cache, &entry->link);
+}
+
 static struct xkb_keymap *
 compile_keymap(struct hikari_xkb_config *xkb_config)
 {
@@ -349,10 +425,18 @@ compile_keymap(struct hikari_xkb_config *xkb_config)
   rules.variant = xkb_config->variant.value;
   rules.options = xkb_config->options.value;
 
-  struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-  struct xkb_keymap *keymap =
-      xkb_map_new_from_names(context, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
-  xkb_context_unref(context);
+  struct keymap_cache_entry *entry = find_cached_keymap(&rules);
+
+  if (entry != NULL) {
+    return xkb_keymap_ref(entry->keymap);
+  }
+
+  struct xkb_keymap *keymap = xkb_map_new_from_names(
+      get_context(), &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+
+  if (keymap != NULL) {
+    cache_keymap(&rules, keymap);
+  }
 
   return keymap;
 }
@@ -380,3 +464,58 @@ hikari_keyboard_config_compile_keymap(
 
   return true;
 }
+
+static void
+remove_cached_keymap(struct keymap_cache_entry *entry)
+{
+  wl_list_remove(&entry->link);
+
+  free(entry->rules);
+  free(entry->model);
+  free(entry->layout);
+  free(entry->variant);
+  free(entry->options);
+  xkb_keymap_unref(entry->keymap);
+
+  hikari_free(entry);
+}
+
+static bool
+is_keymap_referenced(
+    struct xkb_keymap *keymap, struct wl_list *keyboard_configs)
+{
+  struct hikari_keyboard_config *keyboard_config;
+  wl_list_for_each (keyboard_config, keyboard_configs, link) {
+    if (keyboard_config->xkb.type == HIKARI_XKB_TYPE_KEYMAP &&
+        keyboard_config->xkb.value.keymap == keymap) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void
+hikari_keymaps_prune(struct wl_list *keyboard_configs)
+{
+  // keyboards hold their own references, dropping the cached one only frees
+  // keymaps that nothing uses anymore.
+  struct keymap_cache_entry *entry, *entry_temp;
+  wl_list_for_each_safe (entry, entry_temp, &keymap_cache, link) {
+    if (!is_keymap_referenced(entry->keymap, keyboard_configs)) {
+      remove_cached_keymap(entry);
+    }
+  }
+}
+
+void
+hikari_keymaps_fini(void)
+{
+  struct keymap_cache_entry *entry, *entry_temp;
+  wl_list_for_each_safe (entry, entry_temp, &keymap_cache, link) {
+    remove_cached_keymap(entry);
+  }
+
+  xkb_context_unref(context);
+  context = NULL;
+}
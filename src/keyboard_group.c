@@ -0,0 +1,136 @@
+#include <hikari/keyboard_group.h>
+
+#include <assert.h>
+
+#include <wlr/types/wlr_input_device.h>
+#include <wlr/types/wlr_keyboard.h>
+#include <wlr/types/wlr_seat.h>
+#include <wlr/types/wlr_virtual_keyboard_v1.h>
+
+#include <hikari/keyboard.h>
+#include <hikari/memory.h>
+#include <hikari/server.h>
+
+bool
+hikari_keyboard_group_matches(struct hikari_keyboard_group *keyboard_group,
+    struct xkb_keymap *keymap,
+    int repeat_rate,
+    int repeat_delay)
+{
+  struct wlr_keyboard *wlr_keyboard =
+      &keyboard_group->wlr_keyboard_group->keyboard;
+
+  // keymaps compiled from the same rules are shared, comparing them by
+  // identity is sufficient.
+  return wlr_keyboard->keymap == keymap &&
+         wlr_keyboard->repeat_info.rate == repeat_rate &&
+         wlr_keyboard->repeat_info.delay == repeat_delay;
+}
+
+static struct hikari_keyboard_group *
+create_keyboard_group(struct wlr_keyboard *wlr_keyboard)
+{
+  struct wlr_keyboard_group *wlr_keyboard_group = wlr_keyboard_group_create();
+
+  if (wlr_keyboard_group == NULL) {
+    return NULL;
+  }
+
+  struct hikari_keyboard_group *keyboard_group =
+      hikari_malloc(sizeof(struct hikari_keyboard_group));
+
+  keyboard_group->wlr_keyboard_group = wlr_keyboard_group;
+  keyboard_group->nr_keyboards = 0;
+  wlr_keyboard_group->data = keyboard_group;
+
+  wlr_keyboard_set_keymap(&wlr_keyboard_group->keyboard, wlr_keyboard->keymap);
+  wlr_keyboard_set_repeat_info(&wlr_keyboard_group->keyboard,
+      wlr_keyboard->repeat_info.rate,
+      wlr_keyboard->repeat_info.delay);
+
+  wl_list_insert(&hikari_server.keyboard_groups,
+      &keyboard_group->server_keyboard_groups);
+
+  return keyboard_group;
+}
+
+static void
+destroy_keyboard_group(struct hikari_keyboard_group *keyboard_group)
+{
+  assert(keyboard_group->nr_keyboards == 0);
+
+  wl_list_remove(&keyboard_group->server_keyboard_groups);
+  wlr_keyboard_group_destroy(keyboard_group->wlr_keyboard_group);
+
+  hikari_free(keyboard_group);
+}
+
+void
+hikari_keyboard_group_join(struct hikari_keyboard *keyboard)
+{
+  assert(keyboard->group == NULL);
+
+  // virtual keyboard clients upload their own keymaps, a group would pass
+  // them on to every physical keyboard in it.
+  if (wlr_input_device_get_virtual_keyboard(keyboard->device) != NULL) {
+    return;
+  }
+
+  struct wlr_keyboard *wlr_keyboard = keyboard->device->keyboard;
+  struct hikari_keyboard_group *keyboard_group = NULL;
+
+  struct hikari_keyboard_group *group;
+  wl_list_for_each (
+      group, &hikari_server.keyboard_groups, server_keyboard_groups) {
+    if (hikari_keyboard_group_matches(group,
+            wlr_keyboard->keymap,
+            wlr_keyboard->repeat_info.rate,
+            wlr_keyboard->repeat_info.delay)) {
+      keyboard_group = group;
+      break;
+    }
+  }
+
+  if (keyboard_group == NULL) {
+    keyboard_group = create_keyboard_group(wlr_keyboard);
+
+    if (keyboard_group == NULL) {
+      return;
+    }
+  }
+
+  if (!wlr_keyboard_group_add_keyboard(
+          keyboard_group->wlr_keyboard_group, wlr_keyboard)) {
+    if (keyboard_group->nr_keyboards == 0) {
+      destroy_keyboard_group(keyboard_group);
+    }
+    return;
+  }
+
+  keyboard_group->nr_keyboards++;
+  keyboard->group = keyboard_group;
+
+  // the device is replaced by its group as the keyboard of the seat.
+  if (wlr_seat_get_keyboard(hikari_server.seat) == wlr_keyboard) {
+    hikari_keyboard_activate(keyboard);
+  }
+}
+
+void
+hikari_keyboard_group_leave(struct hikari_keyboard *keyboard)
+{
+  struct hikari_keyboard_group *keyboard_group = keyboard->group;
+
+  if (keyboard_group == NULL) {
+    return;
+  }
+
+  wlr_keyboard_group_remove_keyboard(
+      keyboard_group->wlr_keyboard_group, keyboard->device->keyboard);
+
+  keyboard->group = NULL;
+
+  if (--keyboard_group->nr_keyboards == 0) {
+    destroy_keyboard_group(keyboard_group);
+  }
+}
@@ -0,0 +1,183 @@
+#include <hikari/latency.h>
+
+#ifndef NDEBUG
+#include <stdio.h>
+#include <string.h>
+
+#include <hikari/server.h>
+
+// input that was not reflected by any damage within this time is considered
+// to not have caused any.
+#define HIKARI_LATENCY_INPUT_TIMEOUT 1000
+
+static const char *event_type_names[HIKARI_LATENCY_EVENT_TYPES] = {
+  "key", "button", "motion"
+};
+
+static const char *mode_names[HIKARI_LATENCY_MODES] = { "normal",
+  "dnd",
+  "group-assign",
+  "input-grab",
+  "layout-select",
+  "lock",
+  "mark-assign",
+  "mark-select",
+  "move",
+  "resize",
+  "sheet-assign" };
+
+static struct hikari_latency_input pending = { .valid = false, .seq = 0 };
+
+static int
+current_mode(void)
+{
+  struct hikari_mode *modes[HIKARI_LATENCY_MODES] = {
+    (struct hikari_mode *)&hikari_server.normal_mode,
+    (struct hikari_mode *)&hikari_server.dnd_mode,
+    (struct hikari_mode *)&hikari_server.group_assign_mode,
+    (struct hikari_mode *)&hikari_server.input_grab_mode,
+    (struct hikari_mode *)&hikari_server.layout_select_mode,
+    (struct hikari_mode *)&hikari_server.lock_mode,
+    (struct hikari_mode *)&hikari_server.mark_assign_mode,
+    (struct hikari_mode *)&hikari_server.mark_select_mode,
+    (struct hikari_mode *)&hikari_server.move_mode,
+    (struct hikari_mode *)&hikari_server.resize_mode,
+    (struct hikari_mode *)&hikari_server.sheet_assign_mode,
+  };
+
+  for (int i = 0; i < HIKARI_LATENCY_MODES; i++) {
+    if (hikari_server.mode == modes[i]) {
+      return i;
+    }
+  }
+
+  return 0;
+}
+
+static uint32_t
+now_msec(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+void
+hikari_latency_init(struct hikari_latency *latency)
+{
+  latency->tagged_seq = 0;
+  latency->damaged.valid = false;
+  latency->committed.valid = false;
+
+  memset(latency->histograms, 0, sizeof(latency->histograms));
+}
+
+void
+hikari_latency_input(enum hikari_latency_event_type type, uint32_t time_msec)
+{
+  // coalesced events of the same type are measured from the first event that
+  // has not been reflected yet.
+  if (pending.valid && !pending.tagged && pending.type == type &&
+      now_msec() - pending.time_msec <= HIKARI_LATENCY_INPUT_TIMEOUT) {
+    return;
+  }
+
+  pending.valid = true;
+  pending.tagged = false;
+  pending.seq++;
+  pending.type = type;
+  pending.mode = current_mode();
+  pending.time_msec = time_msec;
+}
+
+void
+hikari_latency_damage(struct hikari_latency *latency)
+{
+  if (!pending.valid || latency->tagged_seq == pending.seq) {
+    return;
+  }
+
+  uint32_t now = now_msec();
+
+  if (now - pending.time_msec > HIKARI_LATENCY_INPUT_TIMEOUT) {
+    pending.valid = false;
+    return;
+  }
+
+  // damage that never got rendered, e.g. because it was outside of the
+  // visible area, must not block tagging forever.
+  if (latency->damaged.valid &&
+      now - latency->damaged.time_msec <= HIKARI_LATENCY_INPUT_TIMEOUT) {
+    return;
+  }
+
+  pending.tagged = true;
+  latency->tagged_seq = pending.seq;
+  latency->damaged = pending;
+}
+
+void
+hikari_latency_commit(struct hikari_latency *latency)
+{
+  if (!latency->damaged.valid) {
+    return;
+  }
+
+  latency->committed = latency->damaged;
+  latency->damaged.valid = false;
+}
+
+void
+hikari_latency_present(struct hikari_latency *latency, struct timespec *when)
+{
+  struct hikari_latency_input *input = &latency->committed;
+
+  if (!input->valid) {
+    return;
+  }
+
+  input->valid = false;
+
+  uint32_t when_msec = when->tv_sec * 1000 + when->tv_nsec / 1000000;
+  uint32_t elapsed = when_msec - input->time_msec;
+
+  int bucket = 0;
+  while (bucket < HIKARI_LATENCY_BUCKETS - 1 && elapsed >= (1U << bucket)) {
+    bucket++;
+  }
+
+  latency->histograms[input->type][input->mode][bucket]++;
+}
+
+void
+hikari_latency_dump(struct hikari_latency *latency, const char *output_name)
+{
+  for (int type = 0; type < HIKARI_LATENCY_EVENT_TYPES; type++) {
+    for (int mode = 0; mode < HIKARI_LATENCY_MODES; mode++) {
+      unsigned long *histogram = latency->histograms[type][mode];
+      unsigned long total = 0;
+
+      for (int i = 0; i < HIKARI_LATENCY_BUCKETS; i++) {
+        total += histogram[i];
+      }
+
+      if (total == 0) {
+        continue;
+      }
+
+      printf("%s %s %s", output_name, event_type_names[type], mode_names[mode]);
+
+      for (int i = 0; i < HIKARI_LATENCY_BUCKETS - 1; i++) {
+        printf(" <%u:%lu", 1U << i, histogram[i]);
+      }
+
+      printf(" >=%u:%lu",
+          1U << (HIKARI_LATENCY_BUCKETS - 2),
+          histogram[HIKARI_LATENCY_BUCKETS - 1]);
+
+      printf("\n");
+    }
+  }
+}
+#endif
@@ -8,6 +8,7 @@
 #include <wlr/types/wlr_seat.h>
 #include <wlr/types/wlr_xdg_shell.h>
 
+#include <hikari/fractional_scale.h>
 #include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
@@ -202,6 +203,7 @@ hikari_layer_init(
   layer->layer = wlr_layer_surface->pending.layer;
   layer->surface = wlr_layer_surface;
   layer->mapped = false;
+  layer->arranged = false;
 
   wlr_layer_surface->output = output->wlr_output;
 
@@ -349,12 +351,28 @@ done:
   }
 }
 
+static bool
+changed_state(struct wlr_layer_surface_v1_state *old_state,
+    struct wlr_layer_surface_v1_state *state)
+{
+  return old_state->anchor != state->anchor ||
+         old_state->exclusive_zone != state->exclusive_zone ||
+         old_state->margin.top != state->margin.top ||
+         old_state->margin.right != state->margin.right ||
+         old_state->margin.bottom != state->margin.bottom ||
+         old_state->margin.left != state->margin.left ||
+         old_state->desired_width != state->desired_width ||
+         old_state->desired_height != state->desired_height ||
+         old_state->layer != state->layer;
+}
+
 static void
 commit_handler(struct wl_listener *listener, void *data)
 {
   struct hikari_layer *layer = wl_container_of(listener, layer, commit);
   struct wlr_box old_geometry = layer->geometry;
   struct hikari_output *output = layer->output;
+  struct wlr_layer_surface_v1_state *state = &layer->surface->current;
 
   if (!layer->mapped) {
     calculate_geometry(layer);
@@ -363,6 +381,18 @@ commit_handler(struct wl_listener *listener, void *data)
 
   assert(layer->mapped);
 
+  // most commits only update the buffer, only rearrange the output and
+  // reconfigure the surface when the layer state actually changed.
+  if (layer->arranged && !changed_state(&layer->state, state)) {
+    damage(layer, false);
+    return;
+  }
+
+  layer->state = *state;
+  layer->arranged = true;
+
+  hikari_spatial_index_invalidate(&output->spatial_index);
+
   calculate_exclusive(layer->output);
   calculate_geometry(layer);
 
@@ -427,7 +457,13 @@ map(struct hikari_layer *layer)
 
   layer->mapped = true;
 
+  // the fractional scale object can be created before the surface got its
+  // layer role.
+  hikari_fractional_scale_notify(
+      wlr_layer_surface->surface, layer->output->wlr_output->scale);
+
   damage(layer, true);
+  hikari_spatial_index_invalidate(&layer->output->spatial_index);
 
   hikari_server_cursor_focus();
 }
@@ -461,8 +497,10 @@ unmap(struct hikari_layer *layer)
   wl_signal_add(&layer->surface->events.map, &layer->map);
 
   layer->mapped = false;
+  layer->arranged = false;
 
   damage(layer, true);
+  hikari_spatial_index_invalidate(&layer->output->spatial_index);
 
   calculate_exclusive(layer->output);
 
@@ -476,6 +514,45 @@ unmap(struct hikari_layer *layer)
   hikari_server_cursor_focus();
 }
 
+static void
+arrange_layers(struct wl_list *layers)
+{
+  struct hikari_layer *layer;
+  wl_list_for_each (layer, layers, layer_surfaces) {
+    struct wlr_box old_geometry = layer->geometry;
+
+    calculate_geometry(layer);
+
+    if (!layer->mapped) {
+      continue;
+    }
+
+    layer->state = layer->surface->current;
+    layer->arranged = true;
+
+    if (memcmp(&old_geometry, &layer->geometry, sizeof(struct wlr_box)) != 0) {
+      hikari_output_add_damage(layer->output, &old_geometry);
+      hikari_output_add_damage(layer->output, &layer->geometry);
+    }
+  }
+}
+
+void
+hikari_layer_shell_arrange(struct hikari_output *output)
+{
+  // the output changed underneath the layers, their own state did not, so
+  // they would not be arranged again on their next commit.
+  calculate_exclusive(output);
+
+  arrange_layers(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY]);
+  arrange_layers(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_TOP]);
+  arrange_layers(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM]);
+  arrange_layers(&output->layers[ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND]);
+
+  hikari_spatial_index_invalidate(&output->spatial_index);
+  hikari_server_cursor_focus();
+}
+
 static void
 unmap_handler(struct wl_listener *listener, void *data)
 {
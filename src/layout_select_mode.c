@@ -79,7 +79,7 @@ cancel(void)
   struct hikari_view *focus_view = hikari_server.workspace->focus_view;
 
   if (focus_view != NULL) {
-    hikari_view_damage_whole(focus_view);
+    hikari_view_damage_border(focus_view);
     hikari_indicator_damage(&hikari_server.indicator, focus_view);
   }
 }
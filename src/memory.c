@@ -14,6 +14,12 @@ hikari_calloc(size_t number, size_t size)
   return calloc(number, size);
 }
 
+void *
+hikari_realloc(void *ptr, size_t size)
+{
+  return realloc(ptr, size);
+}
+
 void
 hikari_free(void *ptr)
 {
@@ -1,5 +1,7 @@
 #include <hikari/normal_mode.h>
 
+#include <math.h>
+
 #include <wlr/types/wlr_cursor.h>
 #include <wlr/types/wlr_seat.h>
 
@@ -12,6 +14,7 @@
 #include <hikari/keyboard.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
+#include <hikari/spatial_index.h>
 #include <hikari/view.h>
 
 #ifndef NDEBUG
@@ -29,31 +32,98 @@ struct cursor_down_state {
 
 static struct cursor_down_state cursor_down_state;
 
-static bool
+static struct hikari_binding *
 handle_input(struct hikari_binding_group *map, uint32_t code)
 {
-  int nbindings = map->nbindings;
-  struct hikari_binding *bindings = map->bindings;
+  struct hikari_binding *binding = hikari_binding_group_find(map, code);
 
-  for (int i = 0; i < nbindings; i++) {
-    struct hikari_binding *binding = &bindings[i];
+  if (binding == NULL) {
+    return NULL;
+  }
 
-    if (binding->keycode == code) {
-      struct hikari_event_action *event_action;
+  struct hikari_event_action *event_action;
 
-      if (binding->action->end.action != NULL) {
-        hikari_server.normal_mode.pending_action = &binding->action->end;
-      }
+  if (binding->action->end.action != NULL) {
+    hikari_server.normal_mode.pending_action = &binding->action->end;
+  }
 
-      event_action = &binding->action->begin;
-      if (event_action->action != NULL) {
-        event_action->action(event_action->arg);
-      }
-      return true;
-    }
+  event_action = &binding->action->begin;
+  if (event_action->action != NULL) {
+    event_action->action(event_action->arg);
   }
+  return binding;
+}
 
-  return false;
+static int
+repeat_interval(struct hikari_normal_mode *normal_mode)
+{
+  struct hikari_action_repeat *repeat = &normal_mode->repeat_action.repeat;
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  long held_msec = (now.tv_sec - normal_mode->repeat_start.tv_sec) * 1000 +
+                   (now.tv_nsec - normal_mode->repeat_start.tv_nsec) / 1000000;
+
+  // acceleration increases the rate for every second the key is held.
+  long rate = repeat->rate + repeat->acceleration * held_msec / 1000;
+  long interval = 1000 / rate;
+
+  return interval > 0 ? interval : 1;
+}
+
+static int
+repeat_handler(void *data)
+{
+  struct hikari_normal_mode *normal_mode = data;
+  struct hikari_event_action *event_action = &normal_mode->repeat_action.begin;
+
+  if (!hikari_server_in_normal_mode()) {
+    hikari_normal_mode_stop_repeat(normal_mode);
+    return 0;
+  }
+
+  event_action->action(event_action->arg);
+
+  // the action might have left normal mode or reloaded the configuration.
+  if (normal_mode->repeat_timer != NULL) {
+    wl_event_source_timer_update(
+        normal_mode->repeat_timer, repeat_interval(normal_mode));
+  }
+
+  return 0;
+}
+
+static void
+start_repeat(struct hikari_normal_mode *normal_mode,
+    struct hikari_action *action,
+    uint32_t keycode)
+{
+  assert(normal_mode->repeat_timer == NULL);
+
+  if (action->repeat.rate == 0 || action->begin.action == NULL) {
+    return;
+  }
+
+  normal_mode->repeat_action = *action;
+  normal_mode->repeat_keycode = keycode;
+  normal_mode->repeat_timer = wl_event_loop_add_timer(
+      hikari_server.event_loop, repeat_handler, normal_mode);
+
+  clock_gettime(CLOCK_MONOTONIC, &normal_mode->repeat_start);
+  normal_mode->repeat_start.tv_sec += action->repeat.delay / 1000;
+  normal_mode->repeat_start.tv_nsec += (action->repeat.delay % 1000) * 1000000;
+
+  wl_event_source_timer_update(normal_mode->repeat_timer,
+      action->repeat.delay > 0 ? action->repeat.delay : 1);
+}
+
+void
+hikari_normal_mode_stop_repeat(struct hikari_normal_mode *normal_mode)
+{
+  if (normal_mode->repeat_timer != NULL) {
+    wl_event_source_remove(normal_mode->repeat_timer);
+    normal_mode->repeat_timer = NULL;
+  }
 }
 
 static bool
@@ -143,6 +213,60 @@ dump_debug(struct hikari_server *server)
       printf("\n");
     }
   }
+  printf("---------------------------------------------------------------------"
+         "\n");
+  printf("STATISTICS\n");
+  printf("---------------------------------------------------------------------"
+         "\n");
+  printf("moves %lu damage submissions %lu (%.2f per move)\n",
+      server->statistics.moves,
+      server->statistics.move_damage_submissions,
+      server->statistics.moves > 0
+          ? (double)server->statistics.move_damage_submissions /
+                server->statistics.moves
+          : 0.0);
+  printf("cursor focus requests %lu updates %lu\n",
+      server->statistics.cursor_focus_requests,
+      server->statistics.cursor_focus_updates);
+  printf("indicator rasterizations %lu\n",
+      server->statistics.indicator_rasterizations);
+  struct hikari_keyboard *keyboard;
+  wl_list_for_each (keyboard, &server->keyboards, server_keyboards) {
+    printf("keyboard %s binding resolution %ldus\n",
+        keyboard->device->name,
+        keyboard->binding_resolution_usec);
+  }
+  printf("---------------------------------------------------------------------"
+         "\n");
+  printf("CONFIGURE ROUND-TRIP\n");
+  printf("---------------------------------------------------------------------"
+         "\n");
+  wl_list_for_each (view, &hikari_server.visible_views, visible_server_views) {
+    printf("%p %ums (max %ums) %s\n",
+        view,
+        view->configure_rtt_msec,
+        view->max_configure_rtt_msec,
+        view->title != NULL ? view->title : "");
+  }
+  printf("---------------------------------------------------------------------"
+         "\n");
+  printf("TITLE CHANGES\n");
+  printf("---------------------------------------------------------------------"
+         "\n");
+  wl_list_for_each (view, &hikari_server.visible_views, visible_server_views) {
+    printf("%p %u/s (total %lu)\n",
+        view,
+        view->title_changes.rate,
+        view->title_changes.total);
+  }
+  printf("---------------------------------------------------------------------"
+         "\n");
+  printf("INPUT LATENCY\n");
+  printf("---------------------------------------------------------------------"
+         "\n");
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    hikari_latency_dump(&output->latency, output->wlr_output->name);
+  }
   printf("/////////////////////////////////////////////////////////////////////"
          "\n");
 }
@@ -151,7 +275,10 @@ dump_debug(struct hikari_server *server)
 static void
 modifiers_handler(struct hikari_keyboard *keyboard)
 {
-  wlr_seat_set_keyboard(hikari_server.seat, keyboard->device);
+  // bindings depend on the modifiers that were held when they were pressed.
+  hikari_normal_mode_stop_repeat(&hikari_server.normal_mode);
+
+  hikari_keyboard_activate(keyboard);
   struct hikari_view *focus_view = hikari_server.workspace->focus_view;
 
   if (hikari_server.keyboard_state.mod_released) {
@@ -167,6 +294,10 @@ modifiers_handler(struct hikari_keyboard *keyboard)
 
   if (hikari_server.keyboard_state.mod_changed) {
     if (focus_view != NULL) {
+      if (hikari_server_is_indicating()) {
+        hikari_indicator_refresh(&hikari_server.indicator, focus_view);
+      }
+
       hikari_group_damage(focus_view->group);
       hikari_indicator_damage(&hikari_server.indicator, focus_view);
     }
@@ -181,7 +312,9 @@ modifiers_handler(struct hikari_keyboard *keyboard)
 
 static void
 cancel(void)
-{}
+{
+  hikari_normal_mode_stop_repeat(&hikari_server.normal_mode);
+}
 
 static void
 cursor_down_move(uint32_t time)
@@ -200,23 +333,89 @@ cursor_down_move(uint32_t time)
   wlr_seat_pointer_notify_motion(seat, time, sx, sy);
 }
 
+// remembers the surface found by the last hit-test as long as it is fully
+// exposed, motion within it does not need to walk the scene again.
+static struct {
+  bool valid;
+  unsigned long generation;
+  struct hikari_node *node;
+  struct wlr_surface *surface;
+  double x;
+  double y;
+  struct wlr_box box;
+} last_hit = { .valid = false };
+
+static struct hikari_node *
+cached_node_at(double lx,
+    double ly,
+    struct wlr_surface **surface,
+    double *sx,
+    double *sy)
+{
+  if (!last_hit.valid ||
+      last_hit.generation != hikari_spatial_index_generation() ||
+      !wlr_box_contains_point(&last_hit.box, lx, ly)) {
+    return NULL;
+  }
+
+  double x = lx - last_hit.x;
+  double y = ly - last_hit.y;
+
+  if (!pixman_region32_contains_point(
+          &last_hit.surface->input_region, floor(x), floor(y), NULL)) {
+    return NULL;
+  }
+
+  *surface = last_hit.surface;
+  *sx = x;
+  *sy = y;
+
+  return last_hit.node;
+}
+
+static void
+cache_hit(struct hikari_node *node,
+    struct wlr_surface *surface,
+    double lx,
+    double ly,
+    double sx,
+    double sy)
+{
+  last_hit.valid = hikari_server_exposed_surface_box(
+      node, surface, lx, ly, sx, sy, &last_hit.box);
+
+  if (last_hit.valid) {
+    last_hit.generation = hikari_spatial_index_generation();
+    last_hit.node = node;
+    last_hit.surface = surface;
+    last_hit.x = lx - sx;
+    last_hit.y = ly - sy;
+  }
+}
+
 static void
 cursor_move(uint32_t time)
 {
   assert(hikari_server_in_normal_mode());
 
   double sx, sy;
+  double lx = hikari_server.cursor.wlr_cursor->x;
+  double ly = hikari_server.cursor.wlr_cursor->y;
   struct wlr_seat *seat = hikari_server.seat;
   struct wlr_surface *surface;
   struct hikari_workspace *workspace;
 
-  struct hikari_node *node =
-      hikari_server_node_at(hikari_server.cursor.wlr_cursor->x,
-          hikari_server.cursor.wlr_cursor->y,
-          &surface,
-          &workspace,
-          &sx,
-          &sy);
+  struct hikari_node *node = cached_node_at(lx, ly, &surface, &sx, &sy);
+
+  if (node == NULL) {
+    node = hikari_server_node_at(lx, ly, &surface, &workspace, &sx, &sy);
+
+    if (node != NULL) {
+      cache_hit(node, surface, lx, ly, sx, sy);
+    } else {
+      last_hit.valid = false;
+    }
+  }
 
   if (node != NULL) {
     struct hikari_node *focus_node =
@@ -226,7 +425,9 @@ cursor_move(uint32_t time)
       hikari_node_focus(node);
     }
 
-    wlr_seat_pointer_notify_enter(seat, surface, sx, sy);
+    if (seat->pointer_state.focused_surface != surface) {
+      wlr_seat_pointer_notify_enter(seat, surface, sx, sy);
+    }
     wlr_seat_pointer_notify_motion(seat, time, sx, sy);
   } else {
     if (hikari_server.workspace != workspace) {
@@ -315,6 +516,14 @@ static void
 key_handler(
     struct hikari_keyboard *keyboard, struct wlr_event_keyboard_key *event)
 {
+  struct hikari_normal_mode *normal_mode = &hikari_server.normal_mode;
+
+  // releasing the repeating key or pressing another one stops repeating.
+  if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED ||
+      event->keycode == normal_mode->repeat_keycode) {
+    hikari_normal_mode_stop_repeat(normal_mode);
+  }
+
   if (handle_pending_action()) {
     return;
   }
@@ -322,13 +531,17 @@ key_handler(
   if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED) {
     uint32_t modifiers = hikari_server.keyboard_state.modifiers;
     struct hikari_binding_group *bindings = &keyboard->bindings[modifiers];
+    struct hikari_binding *binding = handle_input(bindings, event->keycode);
 
-    if (handle_input(bindings, event->keycode)) {
+    if (binding != NULL) {
+      if (hikari_server_in_normal_mode()) {
+        start_repeat(normal_mode, binding->action, event->keycode);
+      }
       return;
     }
   }
 
-  wlr_seat_set_keyboard(hikari_server.seat, keyboard->device);
+  hikari_keyboard_activate(keyboard);
   wlr_seat_keyboard_notify_key(
       hikari_server.seat, event->time_msec, event->keycode, event->state);
 }
@@ -343,6 +556,8 @@ hikari_normal_mode_init(struct hikari_normal_mode *normal_mode)
   normal_mode->mode.cancel = cancel;
   normal_mode->mode.cursor_move = cursor_move;
   normal_mode->pending_action = NULL;
+  normal_mode->repeat_keycode = 0;
+  normal_mode->repeat_timer = NULL;
 }
 
 void
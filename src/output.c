@@ -7,9 +7,7 @@
 #include <hikari/memory.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
-#ifdef HAVE_XWAYLAND
 #include <hikari/view.h>
-#endif
 
 static inline void
 render_image_to_surface(cairo_surface_t *output,
@@ -103,9 +101,34 @@ hikari_output_damage_whole(struct hikari_output *output)
 {
   assert(output != NULL);
 
+  hikari_latency_damage(&output->latency);
   wlr_output_damage_add_whole(output->damage);
 }
 
+void
+hikari_output_defer_damage(struct hikari_output *output)
+{
+  assert(output != NULL);
+  assert(!output->damage_deferred);
+
+  output->damage_deferred = true;
+}
+
+void
+hikari_output_flush_damage(struct hikari_output *output)
+{
+  assert(output != NULL);
+  assert(output->damage_deferred);
+
+  output->damage_deferred = false;
+
+  if (output->enabled && pixman_region32_not_empty(&output->deferred_damage)) {
+    wlr_output_damage_add(output->damage, &output->deferred_damage);
+  }
+
+  pixman_region32_clear(&output->deferred_damage);
+}
+
 void
 hikari_output_disable(struct hikari_output *output)
 {
@@ -149,8 +172,79 @@ hikari_output_enable(struct hikari_output *output)
   output->enabled = true;
 }
 
-static void
-output_geometry(struct hikari_output *output)
+static int
+frame_timer_handler(void *data)
+{
+  struct hikari_output *output = data;
+
+  if (output->enabled) {
+    hikari_output_schedule_frame(output);
+  }
+
+  return 0;
+}
+
+static inline bool
+is_frame_limited(struct hikari_output *output)
+{
+  return output->frame_limited && output->max_fps > 0;
+}
+
+bool
+hikari_output_throttle_frame(struct hikari_output *output)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  if (is_frame_limited(output)) {
+    int64_t interval = 1000 / output->max_fps;
+    int64_t elapsed = (now.tv_sec - output->last_frame.tv_sec) * 1000 +
+                      (now.tv_nsec - output->last_frame.tv_nsec) / 1000000;
+
+    if (elapsed < interval) {
+      // damage keeps accumulating until the timer schedules the next frame.
+      wl_event_source_timer_update(output->frame_timer, interval - elapsed);
+      return true;
+    }
+  }
+
+  output->last_frame = now;
+
+  return false;
+}
+
+void
+hikari_output_set_max_fps(struct hikari_output *output, int max_fps)
+{
+  assert(max_fps >= 0);
+
+  // a limit that was toggled off at runtime stays off across reloads.
+  bool toggled_off = output->max_fps > 0 && !output->frame_limited;
+
+  output->max_fps = max_fps;
+  output->frame_limited = max_fps > 0 && !toggled_off;
+
+  if (output->enabled) {
+    hikari_output_schedule_frame(output);
+  }
+}
+
+void
+hikari_output_toggle_max_fps(struct hikari_output *output)
+{
+  if (output->max_fps == 0) {
+    return;
+  }
+
+  output->frame_limited = !output->frame_limited;
+
+  if (output->enabled) {
+    hikari_output_schedule_frame(output);
+  }
+}
+
+void
+hikari_output_refresh_geometry(struct hikari_output *output)
 {
   struct wlr_box *output_box = wlr_output_layout_get_box(
       hikari_server.output_layout, output->wlr_output);
@@ -163,6 +257,12 @@ output_geometry(struct hikari_output *output)
   output->usable_area = (struct wlr_box){
     .x = 0, .y = 0, .width = output_box->width, .height = output_box->height
   };
+
+  hikari_spatial_index_invalidate(&output->spatial_index);
+
+#ifdef HAVE_LAYERSHELL
+  hikari_layer_shell_arrange(output);
+#endif
 }
 
 /* static void */
@@ -189,6 +289,19 @@ damage_destroy_handler(struct wl_listener *listener, void *data)
   hikari_output_disable(output);
 }
 
+#ifndef NDEBUG
+static void
+present_handler(struct wl_listener *listener, void *data)
+{
+  struct hikari_output *output = wl_container_of(listener, output, present);
+  struct wlr_output_event_present *event = data;
+
+  if (event->presented) {
+    hikari_latency_present(&output->latency, event->when);
+  }
+}
+#endif
+
 #ifdef HAVE_LAYERSHELL
 static void
 close_layers(struct wl_list *layers)
@@ -225,7 +338,18 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
   output->damage = wlr_output_damage_create(wlr_output);
   output->background = NULL;
   output->enabled = false;
+  output->damage_deferred = false;
+  pixman_region32_init(&output->deferred_damage);
   output->workspace = hikari_malloc(sizeof(struct hikari_workspace));
+  output->max_fps = 0;
+  output->frame_limited = false;
+  output->last_frame = (struct timespec){ 0 };
+  output->frame_timer = wl_event_loop_add_timer(
+      hikari_server.event_loop, frame_timer_handler, output);
+
+  hikari_screenshot_init(&output->screenshot);
+  hikari_spatial_index_init(&output->spatial_index);
+  hikari_latency_init(&output->latency);
 
 #ifdef HAVE_XWAYLAND
   wl_list_init(&output->unmanaged_xwayland_views);
@@ -246,6 +370,11 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
   output->destroy.notify = destroy_handler;
   wl_signal_add(&wlr_output->events.destroy, &output->destroy);
 
+#ifndef NDEBUG
+  output->present.notify = present_handler;
+  wl_signal_add(&wlr_output->events.present, &output->present);
+#endif
+
   if (!noop) {
     bool first = wl_list_empty(&hikari_server.outputs);
 
@@ -262,6 +391,15 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
 
     wl_list_init(&output->damage_frame.link);
 
+    struct hikari_output_config *output_config =
+        hikari_configuration_resolve_output_config(
+            hikari_configuration, wlr_output->name);
+
+    if (output_config != NULL) {
+      wlr_output_set_scale(wlr_output, output_config->scale.value);
+      hikari_output_set_max_fps(output, output_config->max_fps.value);
+    }
+
     if (!hikari_server_in_lock_mode()) {
       hikari_output_enable(output);
     } else if (hikari_lock_mode_are_outputs_disabled(
@@ -269,10 +407,6 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
       hikari_output_disable(output);
     }
 
-    struct hikari_output_config *output_config =
-        hikari_configuration_resolve_output_config(
-            hikari_configuration, wlr_output->name);
-
     if (output_config != NULL && output_config->position.value.type ==
                                      HIKARI_POSITION_CONFIG_TYPE_ABSOLUTE) {
       int x = output_config->position.value.config.absolute.x;
@@ -283,7 +417,7 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
       wlr_output_layout_add_auto(hikari_server.output_layout, wlr_output);
     }
 
-    output_geometry(output);
+    hikari_output_refresh_geometry(output);
 
     if (first) {
       hikari_workspace_merge(
@@ -308,6 +442,13 @@ hikari_output_fini(struct hikari_output *output)
   hikari_output_disable(output);
 
   wl_list_remove(&output->destroy.link);
+#ifndef NDEBUG
+  wl_list_remove(&output->present.link);
+#endif
+  wl_event_source_remove(output->frame_timer);
+  pixman_region32_fini(&output->deferred_damage);
+  hikari_spatial_index_invalidate(&output->spatial_index);
+  hikari_spatial_index_fini(&output->spatial_index);
 
   struct hikari_workspace *workspace = output->workspace;
 
@@ -353,6 +494,27 @@ hikari_output_move(struct hikari_output *output, double lx, double ly)
       hikari_server.output_layout, output->wlr_output, lx, ly);
 }
 
+void
+hikari_output_set_scale(struct hikari_output *output, double scale)
+{
+  struct wlr_output *wlr_output = output->wlr_output;
+
+  wlr_output_set_scale(wlr_output, scale);
+
+  if (!wlr_output_commit(wlr_output)) {
+    return;
+  }
+
+  struct hikari_view *view;
+  wl_list_for_each (view, &output->views, output_views) {
+    hikari_view_refresh_scale(view);
+  }
+
+  if (output->enabled) {
+    hikari_output_damage_whole(output);
+  }
+}
+
 #define CYCLE_OUTPUT(name)                                                     \
   struct hikari_output *hikari_output_##name(struct hikari_output *output)     \
   {                                                                            \
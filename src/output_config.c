@@ -23,6 +23,8 @@ hikari_output_config_init(
   hikari_output_config_init_background_fit(
       output_config, HIKARI_BACKGROUND_STRETCH);
   hikari_output_config_init_position(output_config, default_position);
+  hikari_output_config_init_scale(output_config, 1.0);
+  hikari_output_config_init_max_fps(output_config, 0);
 }
 
 void
@@ -51,5 +53,7 @@ hikari_output_config_merge(struct hikari_output_config *output_config,
 
   MERGE(background_fit);
   MERGE(position);
+  MERGE(scale);
+  MERGE(max_fps);
 #undef MERGE
 }
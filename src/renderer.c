@@ -6,6 +6,7 @@
 #include <hikari/geometry.h>
 #include <hikari/output.h>
 #include <hikari/renderer.h>
+#include <hikari/single_pixel_buffer.h>
 #include <hikari/view.h>
 
 #ifdef HAVE_XWAYLAND
@@ -25,79 +26,130 @@
 #endif
 
 static inline void
-renderer_scissor(struct wlr_output *wlr_output,
-    struct wlr_renderer *renderer,
-    pixman_box32_t *rect)
+renderer_scissor(struct wlr_renderer *wlr_renderer, pixman_box32_t *rect)
 {
-  assert(wlr_output != NULL);
-
   struct wlr_box box = { .x = rect->x1,
     .y = rect->y1,
     .width = rect->x2 - rect->x1,
     .height = rect->y2 - rect->y1 };
 
-  wlr_renderer_scissor(renderer, &box);
+  wlr_renderer_scissor(wlr_renderer, &box);
 }
 
-static inline void
-rect_render(float color[static 4],
+// the clip region of a primitive is computed once, primitives outside of the
+// frame damage are skipped before any matrix or scissor setup.
+static inline bool
+render_pass_clip(struct hikari_renderer *renderer,
     struct wlr_box *box,
-    struct hikari_renderer *renderer)
+    pixman_region32_t *clip)
 {
-  pixman_region32_t damage;
-  pixman_region32_init(&damage);
-  pixman_region32_union_rect(
-      &damage, &damage, box->x, box->y, box->width, box->height);
+  pixman_region32_init_rect(clip, box->x, box->y, box->width, box->height);
+  pixman_region32_intersect(clip, clip, renderer->damage);
+
+  return pixman_region32_not_empty(clip);
+}
 
-  pixman_region32_intersect(&damage, &damage, renderer->damage);
-  bool damaged = pixman_region32_not_empty(&damage);
-  if (!damaged) {
-    goto buffer_damage_finish;
+static inline void
+render_pass_add_rect(struct hikari_renderer *renderer,
+    struct wlr_box *box,
+    const float color[static 4])
+{
+  pixman_region32_t clip;
+  if (!render_pass_clip(renderer, box, &clip)) {
+    goto clip_finish;
   }
 
   struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
   struct wlr_output *wlr_output = renderer->wlr_output;
-  assert(renderer);
 
   float matrix[9];
   wlr_matrix_project_box(
       matrix, box, WL_OUTPUT_TRANSFORM_NORMAL, 0, wlr_output->transform_matrix);
 
   int nrects;
-  pixman_box32_t *rects = pixman_region32_rectangles(&damage, &nrects);
+  pixman_box32_t *rects = pixman_region32_rectangles(&clip, &nrects);
   for (int i = 0; i < nrects; i++) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    renderer_scissor(wlr_renderer, &rects[i]);
     wlr_render_quad_with_matrix(wlr_renderer, color, matrix);
   }
 
-buffer_damage_finish:
-  pixman_region32_fini(&damage);
+clip_finish:
+  pixman_region32_fini(&clip);
 }
 
 static inline void
-render_border(struct hikari_border *border, struct hikari_renderer *renderer)
+render_pass_add_subtexture(struct hikari_renderer *renderer,
+    struct wlr_texture *texture,
+    const struct wlr_fbox *src_box,
+    const float matrix[static 9],
+    struct wlr_box *box,
+    float alpha)
 {
-  if (border->state == HIKARI_BORDER_NONE) {
-    return;
+  pixman_region32_t clip;
+  if (!render_pass_clip(renderer, box, &clip)) {
+    goto clip_finish;
   }
 
-  struct wlr_box *geometry = &border->geometry;
-
-  pixman_region32_t damage;
-  pixman_region32_init(&damage);
-  pixman_region32_union_rect(&damage,
-      &damage,
-      geometry->x,
-      geometry->y,
-      geometry->width,
-      geometry->height);
-  pixman_region32_intersect(&damage, &damage, renderer->damage);
+  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
 
-  bool damaged = pixman_region32_not_empty(&damage);
-  if (!damaged) {
-    goto buffer_damage_finish;
+  int nrects;
+  pixman_box32_t *rects = pixman_region32_rectangles(&clip, &nrects);
+  for (int i = 0; i < nrects; i++) {
+    renderer_scissor(wlr_renderer, &rects[i]);
+    wlr_render_subtexture_with_matrix(
+        wlr_renderer, texture, src_box, matrix, alpha);
   }
 
+clip_finish:
+  pixman_region32_fini(&clip);
+}
+
+static inline void
+render_pass_add_texture(struct hikari_renderer *renderer,
+    struct wlr_texture *texture,
+    const float matrix[static 9],
+    struct wlr_box *box,
+    float alpha)
+{
+  struct wlr_fbox src_box = {
+    .x = 0, .y = 0, .width = texture->width, .height = texture->height
+  };
+
+  render_pass_add_subtexture(renderer, texture, &src_box, matrix, box, alpha);
+}
+
+// borders, indicators and other decorations are laid out in output layout
+// coordinates and need to be scaled to the buffer.
+static inline void
+render_pass_add_layout_rect(struct hikari_renderer *renderer,
+    struct wlr_box *box,
+    const float color[static 4])
+{
+  struct wlr_box scaled;
+  hikari_output_scale_box(renderer->wlr_output->data, box, &scaled);
+
+  render_pass_add_rect(renderer, &scaled, color);
+}
+
+static inline void
+render_pass_add_layout_texture(struct hikari_renderer *renderer,
+    struct wlr_texture *texture,
+    struct wlr_box *box)
+{
+  struct wlr_output *wlr_output = renderer->wlr_output;
+
+  struct wlr_box scaled;
+  hikari_output_scale_box(wlr_output->data, box, &scaled);
+
+  float matrix[9];
+  wlr_matrix_project_box(matrix, &scaled, 0, 0, wlr_output->transform_matrix);
+
+  render_pass_add_texture(renderer, texture, matrix, &scaled, 1);
+}
+
+static inline void
+render_border(struct hikari_border *border, struct hikari_renderer *renderer)
+{
   float *color;
   switch (border->state) {
     case HIKARI_BORDER_INACTIVE:
@@ -109,32 +161,13 @@ render_border(struct hikari_border *border, struct hikari_renderer *renderer)
       break;
 
     default:
-      goto buffer_damage_finish;
-  }
-
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
-  struct wlr_output *wlr_output = renderer->wlr_output;
-  assert(renderer);
-
-  float matrix[9];
-  wlr_matrix_project_box(matrix,
-      geometry,
-      WL_OUTPUT_TRANSFORM_NORMAL,
-      0,
-      wlr_output->transform_matrix);
-
-  int nrects;
-  pixman_box32_t *rects = pixman_region32_rectangles(&damage, &nrects);
-  for (int i = 0; i < nrects; i++) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
-    rect_render(color, &border->top, renderer);
-    rect_render(color, &border->bottom, renderer);
-    rect_render(color, &border->left, renderer);
-    rect_render(color, &border->right, renderer);
+      return;
   }
 
-buffer_damage_finish:
-  pixman_region32_fini(&damage);
+  render_pass_add_layout_rect(renderer, &border->top, color);
+  render_pass_add_layout_rect(renderer, &border->bottom, color);
+  render_pass_add_layout_rect(renderer, &border->left, color);
+  render_pass_add_layout_rect(renderer, &border->right, color);
 }
 
 static void
@@ -146,19 +179,11 @@ render_indicator_bar(struct hikari_indicator_bar *indicator_bar,
   }
 
   struct wlr_box *geometry = renderer->geometry;
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
-  struct wlr_output *wlr_output = renderer->wlr_output;
-
-  float matrix[9];
 
   geometry->width = indicator_bar->width;
   geometry->height = hikari_configuration->font.height;
 
-  wlr_renderer_scissor(wlr_renderer, geometry);
-  wlr_matrix_project_box(matrix, geometry, 0, 0, wlr_output->transform_matrix);
-
-  wlr_render_texture_with_matrix(
-      wlr_renderer, indicator_bar->texture, matrix, 1);
+  render_pass_add_layout_texture(renderer, indicator_bar->texture, geometry);
 }
 
 static inline void
@@ -198,63 +223,10 @@ render_indicator_frame(struct hikari_indicator_frame *indicator_frame,
     float color[static 4],
     struct hikari_renderer *renderer)
 {
-  struct wlr_box *box = renderer->geometry;
-
-  pixman_region32_t damage;
-  pixman_region32_init(&damage);
-  pixman_region32_union_rect(
-      &damage, &damage, box->x, box->y, box->width, box->height);
-
-  pixman_region32_intersect(&damage, &damage, renderer->damage);
-  bool damaged = pixman_region32_not_empty(&damage);
-  if (!damaged) {
-    goto buffer_damage_finish;
-  }
-
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
-  struct wlr_output *wlr_output = renderer->wlr_output;
-
-  float top_matrix[9];
-  float bottom_matrix[9];
-  float left_matrix[9];
-  float right_matrix[9];
-
-  wlr_matrix_project_box(top_matrix,
-      &indicator_frame->top,
-      WL_OUTPUT_TRANSFORM_NORMAL,
-      0,
-      wlr_output->transform_matrix);
-
-  wlr_matrix_project_box(bottom_matrix,
-      &indicator_frame->bottom,
-      WL_OUTPUT_TRANSFORM_NORMAL,
-      0,
-      wlr_output->transform_matrix);
-
-  wlr_matrix_project_box(left_matrix,
-      &indicator_frame->left,
-      WL_OUTPUT_TRANSFORM_NORMAL,
-      0,
-      wlr_output->transform_matrix);
-
-  wlr_matrix_project_box(right_matrix,
-      &indicator_frame->right,
-      WL_OUTPUT_TRANSFORM_NORMAL,
-      0,
-      wlr_output->transform_matrix);
-
-  int nrects;
-  pixman_box32_t *rects = pixman_region32_rectangles(&damage, &nrects);
-  for (int i = 0; i < nrects; i++) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
-    wlr_render_quad_with_matrix(wlr_renderer, color, top_matrix);
-    wlr_render_quad_with_matrix(wlr_renderer, color, bottom_matrix);
-    wlr_render_quad_with_matrix(wlr_renderer, color, left_matrix);
-    wlr_render_quad_with_matrix(wlr_renderer, color, right_matrix);
-  }
-
-buffer_damage_finish:
-  pixman_region32_fini(&damage);
+  render_pass_add_layout_rect(renderer, &indicator_frame->top, color);
+  render_pass_add_layout_rect(renderer, &indicator_frame->bottom, color);
+  render_pass_add_layout_rect(renderer, &indicator_frame->left, color);
+  render_pass_add_layout_rect(renderer, &indicator_frame->right, color);
 }
 
 static inline void
@@ -262,7 +234,6 @@ clear_output(struct hikari_renderer *renderer)
 {
   float *clear_color = hikari_configuration->clear;
   struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
-  struct wlr_output *wlr_output = renderer->wlr_output;
   pixman_region32_t *damage = renderer->damage;
 
 #ifndef NDEBUG
@@ -276,7 +247,7 @@ clear_output(struct hikari_renderer *renderer)
   int nrects;
   pixman_box32_t *rects = pixman_region32_rectangles(damage, &nrects);
   for (int i = 0; i < nrects; ++i) {
-    renderer_scissor(wlr_output, wlr_renderer, &rects[i]);
+    renderer_scissor(wlr_renderer, &rects[i]);
     wlr_renderer_clear(wlr_renderer, clear_color);
   }
 }
@@ -305,39 +276,9 @@ renderer_end(struct hikari_output *output, struct hikari_renderer *renderer)
   wlr_output_set_damage(wlr_output, &frame_damage);
   pixman_region32_fini(&frame_damage);
 
-  wlr_output_commit(wlr_output);
-}
-
-static inline void
-render_texture(struct wlr_texture *texture,
-    struct wlr_output *output,
-    pixman_region32_t *damage,
-    struct wlr_renderer *renderer,
-    const float matrix[static 9],
-    struct wlr_box *box,
-    float alpha)
-{
-  pixman_region32_t local_damage;
-  pixman_region32_init(&local_damage);
-  pixman_region32_union_rect(
-      &local_damage, &local_damage, box->x, box->y, box->width, box->height);
-
-  pixman_region32_intersect(&local_damage, &local_damage, damage);
-
-  bool damaged = pixman_region32_not_empty(&local_damage);
-  if (!damaged) {
-    goto damage_finish;
+  if (wlr_output_commit(wlr_output)) {
+    hikari_latency_commit(&output->latency);
   }
-
-  int nrects;
-  pixman_box32_t *rects = pixman_region32_rectangles(&local_damage, &nrects);
-  for (int i = 0; i < nrects; ++i) {
-    renderer_scissor(output, renderer, &rects[i]);
-    wlr_render_texture_with_matrix(renderer, texture, matrix, alpha);
-  }
-
-damage_finish:
-  pixman_region32_fini(&local_damage);
 }
 
 static void
@@ -345,16 +286,9 @@ render_surface(struct wlr_surface *surface, int sx, int sy, void *data)
 {
   assert(surface != NULL);
 
-  struct wlr_texture *texture = wlr_surface_get_texture(surface);
-
-  if (texture == NULL) {
-    return;
-  }
-
   struct hikari_renderer *renderer = data;
   struct wlr_box *geometry = renderer->geometry;
   struct wlr_output *wlr_output = renderer->wlr_output;
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
 
   double ox = geometry->x + sx;
   double oy = geometry->y + sy;
@@ -364,6 +298,22 @@ render_surface(struct wlr_surface *surface, int sx, int sy, void *data)
     .width = surface->current.width * wlr_output->scale,
     .height = surface->current.height * wlr_output->scale };
 
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      hikari_single_pixel_buffer_from_surface(surface);
+
+  if (single_pixel_buffer != NULL) {
+    if (single_pixel_buffer->color[3] > 0) {
+      render_pass_add_rect(renderer, &box, single_pixel_buffer->color);
+    }
+    return;
+  }
+
+  struct wlr_texture *texture = wlr_surface_get_texture(surface);
+
+  if (texture == NULL) {
+    return;
+  }
+
   float matrix[9];
   enum wl_output_transform transform =
       wlr_output_transform_invert(surface->current.transform);
@@ -371,8 +321,12 @@ render_surface(struct wlr_surface *surface, int sx, int sy, void *data)
   wlr_matrix_project_box(
       matrix, &box, transform, 0, wlr_output->transform_matrix);
 
-  render_texture(
-      texture, wlr_output, renderer->damage, wlr_renderer, matrix, &box, 1);
+  // honors the wp_viewport source crop, the destination size is already
+  // reflected in the surface size.
+  struct wlr_fbox src_box;
+  wlr_surface_get_buffer_source_box(surface, &src_box);
+
+  render_pass_add_subtexture(renderer, texture, &src_box, matrix, &box, 1);
 }
 
 static inline void
@@ -386,7 +340,6 @@ render_background(struct hikari_renderer *renderer, float alpha)
 
   float matrix[9];
   struct wlr_output *wlr_output = output->wlr_output;
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
 
   struct wlr_box geometry = { .x = 0, .y = 0 };
   wlr_output_transformed_resolution(
@@ -394,13 +347,8 @@ render_background(struct hikari_renderer *renderer, float alpha)
 
   wlr_matrix_project_box(matrix, &geometry, 0, 0, wlr_output->transform_matrix);
 
-  render_texture(output->background,
-      wlr_output,
-      renderer->damage,
-      wlr_renderer,
-      matrix,
-      &geometry,
-      alpha);
+  render_pass_add_texture(
+      renderer, output->background, matrix, &geometry, alpha);
 }
 
 #ifdef HAVE_LAYERSHELL
@@ -501,6 +449,11 @@ render_output(struct hikari_output *output, pixman_region32_t *damage)
     hikari_server.mode->render(&renderer);
   }
 
+  if (output->screenshot.pending) {
+    wlr_renderer_scissor(wlr_renderer, NULL);
+    hikari_screenshot_capture(output, wlr_renderer);
+  }
+
   renderer_end(output, &renderer);
 }
 
@@ -561,6 +514,14 @@ hikari_renderer_damage_frame_handler(struct wl_listener *listener, void *data)
   struct hikari_output *output =
       wl_container_of(listener, output, damage_frame);
 
+  // withholding frame callbacks as well makes clients render no faster than
+  // the output.
+  if (hikari_output_throttle_frame(output)) {
+    return;
+  }
+
+  hikari_indicator_commit_title(&hikari_server.indicator, output);
+
   pixman_region32_t buffer_damage;
   pixman_region32_init(&buffer_damage);
 
@@ -570,7 +531,7 @@ hikari_renderer_damage_frame_handler(struct wl_listener *listener, void *data)
     goto render_done;
   }
 
-  if (!needs_frame) {
+  if (!needs_frame && !output->screenshot.pending) {
     wlr_output_rollback(output->wlr_output);
     goto render_done;
   }
@@ -807,16 +768,10 @@ render_lock_indicator(struct hikari_renderer *renderer,
     return;
   }
 
-  float matrix[9];
-  struct wlr_renderer *wlr_renderer = renderer->wlr_renderer;
-  struct wlr_output *wlr_output = renderer->wlr_output;
-
   struct wlr_box geometry;
-  get_lock_indicator_geometry(wlr_output->data, &geometry);
-  wlr_renderer_scissor(wlr_renderer, &geometry);
-  wlr_matrix_project_box(matrix, &geometry, 0, 0, wlr_output->transform_matrix);
+  get_lock_indicator_geometry(renderer->wlr_output->data, &geometry);
 
-  wlr_render_texture_with_matrix(wlr_renderer, texture, matrix, 1);
+  render_pass_add_layout_texture(renderer, texture, &geometry);
 }
 
 void
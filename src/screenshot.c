@@ -0,0 +1,180 @@
+#include <hikari/screenshot.h>
+
+#include <assert.h>
+#include <cairo.h>
+#include <drm_fourcc.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <wlr/types/wlr_output.h>
+
+#include <hikari/configuration.h>
+#include <hikari/memory.h>
+#include <hikari/output.h>
+
+struct screenshot_job {
+  unsigned char *data;
+  int width;
+  int height;
+  int stride;
+  bool y_invert;
+  char path[PATH_MAX];
+};
+
+void
+hikari_screenshot_init(struct hikari_screenshot *screenshot)
+{
+  screenshot->pending = false;
+}
+
+void
+hikari_screenshot_request(
+    struct hikari_output *output, struct wlr_box *geometry)
+{
+  assert(output != NULL);
+
+  if (!output->enabled) {
+    return;
+  }
+
+  struct wlr_output *wlr_output = output->wlr_output;
+  struct wlr_box output_geometry = {
+    .x = 0, .y = 0, .width = wlr_output->width, .height = wlr_output->height
+  };
+
+  // the request is given in output-local coordinates while pixels are read
+  // from the output buffer.
+  struct wlr_box scaled = { .x = geometry->x * wlr_output->scale,
+    .y = geometry->y * wlr_output->scale,
+    .width = geometry->width * wlr_output->scale,
+    .height = geometry->height * wlr_output->scale };
+
+  struct hikari_screenshot *screenshot = &output->screenshot;
+  if (!wlr_box_intersection(&screenshot->geometry, &scaled, &output_geometry)) {
+    return;
+  }
+
+  screenshot->pending = true;
+
+  // the next frame reads the pixels even if nothing got damaged.
+  hikari_output_schedule_frame(output);
+}
+
+static bool
+screenshot_path(char *path, size_t size)
+{
+  const char *directory = hikari_configuration->screenshot_directory;
+
+  if (directory == NULL) {
+    directory = getenv("HOME");
+  }
+
+  if (directory == NULL) {
+    return false;
+  }
+
+  struct timespec now;
+  struct tm tm;
+  char timestamp[32];
+
+  clock_gettime(CLOCK_REALTIME, &now);
+  localtime_r(&now.tv_sec, &tm);
+  strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", &tm);
+
+  int ret = snprintf(path,
+      size,
+      "%s/hikari-%s-%03ld.png",
+      directory,
+      timestamp,
+      now.tv_nsec / 1000000);
+
+  return ret > 0 && (size_t)ret < size;
+}
+
+static void *
+encode_handler(void *data)
+{
+  struct screenshot_job *job = data;
+
+  if (job->y_invert) {
+    unsigned char *row = hikari_malloc(job->stride);
+
+    for (int i = 0; i < job->height / 2; i++) {
+      unsigned char *top = job->data + i * job->stride;
+      unsigned char *bottom = job->data + (job->height - i - 1) * job->stride;
+
+      memcpy(row, top, job->stride);
+      memcpy(top, bottom, job->stride);
+      memcpy(bottom, row, job->stride);
+    }
+
+    hikari_free(row);
+  }
+
+  cairo_surface_t *surface = cairo_image_surface_create_for_data(
+      job->data, CAIRO_FORMAT_RGB24, job->width, job->height, job->stride);
+
+  if (cairo_surface_write_to_png(surface, job->path) != CAIRO_STATUS_SUCCESS) {
+    fprintf(stderr, "error: could not write screenshot \"%s\"\n", job->path);
+  }
+
+  cairo_surface_destroy(surface);
+
+  hikari_free(job->data);
+  hikari_free(job);
+
+  return NULL;
+}
+
+void
+hikari_screenshot_capture(
+    struct hikari_output *output, struct wlr_renderer *wlr_renderer)
+{
+  struct hikari_screenshot *screenshot = &output->screenshot;
+  struct wlr_box *geometry = &screenshot->geometry;
+
+  assert(screenshot->pending);
+
+  screenshot->pending = false;
+
+  struct screenshot_job *job = hikari_malloc(sizeof(struct screenshot_job));
+
+  if (!screenshot_path(job->path, sizeof(job->path))) {
+    hikari_free(job);
+    return;
+  }
+
+  job->width = geometry->width;
+  job->height = geometry->height;
+  job->stride = cairo_format_stride_for_width(CAIRO_FORMAT_RGB24, job->width);
+  job->data = hikari_malloc(job->stride * job->height);
+
+  uint32_t flags = 0;
+  bool success = wlr_renderer_read_pixels(wlr_renderer,
+      DRM_FORMAT_ARGB8888,
+      &flags,
+      job->stride,
+      job->width,
+      job->height,
+      geometry->x,
+      geometry->y,
+      0,
+      0,
+      job->data);
+
+  job->y_invert = flags & WLR_RENDERER_READ_PIXELS_Y_INVERT;
+
+  pthread_t thread;
+  if (!success || pthread_create(&thread, NULL, encode_handler, job) != 0) {
+    fprintf(stderr, "error: could not take screenshot\n");
+    hikari_free(job->data);
+    hikari_free(job);
+    return;
+  }
+
+  pthread_detach(thread);
+}
@@ -2,6 +2,7 @@
 
 #include <errno.h>
 #include <libinput.h>
+#include <math.h>
 #include <unistd.h>
 
 #include <wlr/backend.h>
@@ -20,6 +21,7 @@
 #include <wlr/types/wlr_primary_selection_v1.h>
 #include <wlr/types/wlr_seat.h>
 #include <wlr/types/wlr_server_decoration.h>
+#include <wlr/types/wlr_viewporter.h>
 #include <wlr/types/wlr_xdg_output_v1.h>
 #include <wlr/types/wlr_xdg_shell.h>
 
@@ -44,6 +46,7 @@
 #include <hikari/configuration.h>
 #include <hikari/decoration.h>
 #include <hikari/exec.h>
+#include <hikari/fractional_scale.h>
 #include <hikari/keyboard.h>
 #include <hikari/layout.h>
 #include <hikari/mark.h>
@@ -52,6 +55,7 @@
 #include <hikari/pointer.h>
 #include <hikari/pointer_config.h>
 #include <hikari/sheet.h>
+#include <hikari/single_pixel_buffer.h>
 #include <hikari/switch.h>
 #include <hikari/workspace.h>
 #include <hikari/xdg_view.h>
@@ -389,13 +393,11 @@ node_at(double lx,
   }
 #endif
 
-  struct hikari_view *view = NULL;
-  wl_list_for_each (view, &output_workspace->views, workspace_views) {
-    node = (struct hikari_node *)view;
+  struct hikari_view *view = hikari_spatial_index_view_at(
+      &output->spatial_index, output, ox, oy, surface, sx, sy);
 
-    if (surface_at(node, ox, oy, surface, sx, sy)) {
-      return node;
-    }
+  if (view != NULL) {
+    return (struct hikari_node *)view;
   }
 
 #ifdef HAVE_LAYERSHELL
@@ -424,14 +426,109 @@ hikari_server_node_at(double x,
   return node_at(x, y, surface, workspace, sx, sy);
 }
 
-void
-hikari_server_cursor_focus(void)
+#ifdef HAVE_LAYERSHELL
+static bool
+covered_by_layers(struct wl_list *layers, struct wlr_box *box)
 {
+  struct wlr_box intersection;
+
+  struct hikari_layer *layer;
+  wl_list_for_each (layer, layers, layer_surfaces) {
+    if (layer->surface->current.keyboard_interactive ||
+        wlr_box_intersection(&intersection, &layer->geometry, box)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+#endif
+
+bool
+hikari_server_exposed_surface_box(struct hikari_node *node,
+    struct wlr_surface *surface,
+    double lx,
+    double ly,
+    double sx,
+    double sy,
+    struct wlr_box *box)
+{
+  struct wlr_output *wlr_output =
+      wlr_output_layout_output_at(hikari_server.output_layout, lx, ly);
+
+  if (wlr_output == NULL) {
+    return false;
+  }
+
+  struct hikari_output *output = wlr_output->data;
+
+  struct wlr_box surface_box = { .x = lround(lx - sx) - output->geometry.x,
+    .y = lround(ly - sy) - output->geometry.y,
+    .width = surface->current.width,
+    .height = surface->current.height };
+
+#ifdef HAVE_LAYERSHELL
+  if (covered_by_layers(
+          &output->layers[ZWLR_LAYER_SHELL_V1_LAYER_OVERLAY], &surface_box) ||
+      covered_by_layers(
+          &output->layers[ZWLR_LAYER_SHELL_V1_LAYER_TOP], &surface_box)) {
+    return false;
+  }
+#endif
+
+#ifdef HAVE_XWAYLAND
+  if (!wl_list_empty(&output->unmanaged_xwayland_views)) {
+    return false;
+  }
+#endif
+
+  if (!hikari_spatial_index_is_exposed(
+          &output->spatial_index, node, surface, &surface_box)) {
+    return false;
+  }
+
+  surface_box.x += output->geometry.x;
+  surface_box.y += output->geometry.y;
+
+  // the part of the surface on other outputs is not hit-tested against this
+  // workspace.
+  return wlr_box_intersection(box, &surface_box, &output->geometry);
+}
+
+static void
+cursor_focus_idle_handler(void *data)
+{
+  hikari_server.cursor_focus_idle = NULL;
+
+#ifndef NDEBUG
+  hikari_server.statistics.cursor_focus_updates++;
+#endif
+
   struct timespec now;
-  uint32_t time_msec = (uint32_t)clock_gettime(CLOCK_MONOTONIC, &now);
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  uint32_t time_msec = now.tv_sec * 1000 + now.tv_nsec / 1000000;
+
   hikari_server.mode->cursor_move(time_msec);
 }
 
+void
+hikari_server_cursor_focus(void)
+{
+#ifndef NDEBUG
+  hikari_server.statistics.cursor_focus_requests++;
+#endif
+
+  // refocusing is serviced once when the current event dispatch is done,
+  // pending pointer motion is going to refocus anyway.
+  if (hikari_server.cursor_focus_idle != NULL ||
+      hikari_server.cursor.motion_idle != NULL) {
+    return;
+  }
+
+  hikari_server.cursor_focus_idle = wl_event_loop_add_idle(
+      hikari_server.event_loop, cursor_focus_idle_handler, NULL);
+}
+
 static void
 request_set_primary_selection_handler(struct wl_listener *listener, void *data)
 {
@@ -696,13 +793,10 @@ output_layout_change_handler(struct wl_listener *listener, void *data)
   struct hikari_output *output;
   wl_list_for_each (output, &server->outputs, server_outputs) {
     struct wlr_output *wlr_output = output->wlr_output;
-    struct wlr_box *output_box =
-        wlr_output_layout_get_box(hikari_server.output_layout, wlr_output);
 
-    output->geometry.x = output_box->x;
-    output->geometry.y = output_box->y;
-    output->geometry.width = output_box->width;
-    output->geometry.height = output_box->height;
+    // scale and mode changes resize the output, everything derived from its
+    // box needs to follow.
+    hikari_output_refresh_geometry(output);
 
     struct hikari_output_config *output_config =
         hikari_configuration_resolve_output_config(
@@ -796,10 +890,18 @@ server_init(struct hikari_server *server, char *config_path)
 {
 #ifndef NDEBUG
   server->track_damage = false;
+  server->statistics.moves = 0;
+  server->statistics.move_damage_submissions = 0;
+  server->statistics.cursor_focus_requests = 0;
+  server->statistics.cursor_focus_updates = 0;
+  server->statistics.indicator_rasterizations = 0;
 #endif
   server->shutdown_timer = NULL;
+  server->cursor_focus_idle = NULL;
   server->config_path = config_path;
 
+  hikari_transaction_init(&server->transaction);
+
   hikari_configuration = hikari_malloc(sizeof(struct hikari_configuration));
 
   hikari_configuration_init(hikari_configuration);
@@ -851,6 +953,9 @@ server_init(struct hikari_server *server, char *config_path)
   setenv("WAYLAND_DISPLAY", server->socket, true);
 
   server->compositor = wlr_compositor_create(server->display, server->renderer);
+  server->viewporter = wlr_viewporter_create(server->display);
+  hikari_single_pixel_buffer_manager_create(server->display);
+  hikari_fractional_scale_manager_create(server->display);
 
   server->data_device_manager = wlr_data_device_manager_create(server->display);
 
@@ -893,6 +998,7 @@ server_init(struct hikari_server *server, char *config_path)
 
   wl_list_init(&server->pointers);
   wl_list_init(&server->keyboards);
+  wl_list_init(&server->keyboard_groups);
   wl_list_init(&server->switches);
 
   wl_list_init(&server->groups);
@@ -1020,6 +1126,13 @@ hikari_server_stop(void)
     destroy_shutdown_timer(server);
   }
 
+  if (server->cursor_focus_idle != NULL) {
+    wl_event_source_remove(server->cursor_focus_idle);
+    server->cursor_focus_idle = NULL;
+  }
+
+  hikari_normal_mode_stop_repeat(&server->normal_mode);
+
   hikari_cursor_fini(&server->cursor);
   hikari_indicator_fini(&server->indicator);
 
@@ -1039,6 +1152,7 @@ hikari_server_stop(void)
   hikari_configuration_fini(hikari_configuration);
   hikari_free(hikari_configuration);
   hikari_marks_fini();
+  hikari_keymaps_fini();
 
   free(server->config_path);
 }
@@ -1180,6 +1294,7 @@ update_indication(struct hikari_view *view)
   assert(view != NULL);
   assert(view->group != NULL);
 
+  hikari_indicator_refresh(&hikari_server.indicator, view);
   hikari_group_damage(view->group);
   hikari_indicator_damage(&hikari_server.indicator, view);
 }
@@ -1250,6 +1365,8 @@ hikari_server_enter_group_assign_mode(void *arg)
     return;
   }
 
+  hikari_indicator_refresh(&hikari_server.indicator, focus_view);
+
   hikari_group_assign_mode_enter(focus_view);
 }
 
@@ -1614,6 +1731,8 @@ hikari_server_only_group(void *arg)
 
   struct hikari_group *group = focus_view->group;
 
+  hikari_transaction_begin(&hikari_server.transaction);
+
   struct hikari_output *output;
   wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
     hikari_workspace_clear(output->workspace);
@@ -1621,6 +1740,8 @@ hikari_server_only_group(void *arg)
 
   hikari_group_show(group);
   hikari_server_cursor_focus();
+
+  hikari_transaction_commit(&hikari_server.transaction);
 }
 
 void
@@ -1639,6 +1760,37 @@ hikari_server_hide_group(void *arg)
   hikari_server_cursor_focus();
 }
 
+void
+hikari_server_toggle_max_fps(void *arg)
+{
+  hikari_output_toggle_max_fps(hikari_server.workspace->output);
+}
+
+void
+hikari_server_screenshot_output(void *arg)
+{
+  struct hikari_output *output = hikari_server.workspace->output;
+  struct wlr_box geometry = { .x = 0,
+    .y = 0,
+    .width = output->geometry.width,
+    .height = output->geometry.height };
+
+  hikari_screenshot_request(output, &geometry);
+}
+
+void
+hikari_server_screenshot_view(void *arg)
+{
+  struct hikari_view *focus_view = hikari_server.workspace->focus_view;
+
+  if (focus_view == NULL) {
+    return;
+  }
+
+  hikari_screenshot_request(
+      focus_view->output, hikari_view_border_geometry(focus_view));
+}
+
 #ifndef NDEBUG
 void
 hikari_server_toggle_damage_tracking(void *arg)
@@ -7,7 +7,9 @@
 #include <hikari/group.h>
 #include <hikari/layout.h>
 #include <hikari/memory.h>
+#include <hikari/server.h>
 #include <hikari/split.h>
+#include <hikari/transaction.h>
 #include <hikari/view.h>
 
 void
@@ -440,6 +442,8 @@ hikari_sheet_is_visible(struct hikari_sheet *sheet)
 
 #define SHOW_VIEWS(cond)                                                       \
   {                                                                            \
+    hikari_transaction_begin(&hikari_server.transaction);                      \
+                                                                               \
     struct hikari_view *view, *view_temp;                                      \
     wl_list_for_each_reverse_safe (                                            \
         view, view_temp, &sheet->views, sheet_views) {                         \
@@ -451,6 +455,8 @@ hikari_sheet_is_visible(struct hikari_sheet *sheet)
         }                                                                      \
       }                                                                        \
     }                                                                          \
+                                                                               \
+    hikari_transaction_commit(&hikari_server.transaction);                     \
   }
 
 void
@@ -0,0 +1,241 @@
+#include <hikari/single_pixel_buffer.h>
+
+#include <assert.h>
+#include <drm_fourcc.h>
+
+#include <wayland-server-protocol.h>
+
+#include <wlr/interfaces/wlr_buffer.h>
+
+#include <hikari/memory.h>
+
+#include "single-pixel-buffer-v1-protocol.h"
+
+#define SINGLE_PIXEL_BUFFER_MANAGER_VERSION 1
+
+static const struct wlr_buffer_impl buffer_impl;
+static const struct wl_buffer_interface wl_buffer_impl;
+
+static struct hikari_single_pixel_buffer *
+single_pixel_buffer_from_resource(struct wl_resource *resource)
+{
+  assert(wl_resource_instance_of(
+      resource, &wl_buffer_interface, &wl_buffer_impl));
+
+  return wl_resource_get_user_data(resource);
+}
+
+struct hikari_single_pixel_buffer *
+hikari_single_pixel_buffer_from_buffer(struct wlr_buffer *wlr_buffer)
+{
+  if (wlr_buffer == NULL || wlr_buffer->impl != &buffer_impl) {
+    return NULL;
+  }
+
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      wl_container_of(wlr_buffer, single_pixel_buffer, buffer);
+
+  return single_pixel_buffer;
+}
+
+static void
+buffer_handle_destroy(struct wl_client *client, struct wl_resource *resource)
+{
+  wl_resource_destroy(resource);
+}
+
+static const struct wl_buffer_interface wl_buffer_impl = {
+  .destroy = buffer_handle_destroy,
+};
+
+static bool
+buffer_resource_is_instance(struct wl_resource *resource)
+{
+  return wl_resource_instance_of(
+      resource, &wl_buffer_interface, &wl_buffer_impl);
+}
+
+static struct wlr_buffer *
+buffer_from_resource(struct wl_resource *resource)
+{
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      single_pixel_buffer_from_resource(resource);
+
+  return &single_pixel_buffer->buffer;
+}
+
+static const struct wlr_buffer_resource_interface buffer_resource_interface = {
+  .name = "hikari_single_pixel_buffer",
+  .is_instance = buffer_resource_is_instance,
+  .from_resource = buffer_from_resource,
+};
+
+static void
+buffer_destroy(struct wlr_buffer *wlr_buffer)
+{
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      hikari_single_pixel_buffer_from_buffer(wlr_buffer);
+
+  wl_list_remove(&single_pixel_buffer->release.link);
+
+  hikari_free(single_pixel_buffer);
+}
+
+static bool
+buffer_begin_data_ptr_access(struct wlr_buffer *wlr_buffer,
+    uint32_t flags,
+    void **data,
+    uint32_t *format,
+    size_t *stride)
+{
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      hikari_single_pixel_buffer_from_buffer(wlr_buffer);
+
+  if (flags & WLR_BUFFER_DATA_PTR_ACCESS_WRITE) {
+    return false;
+  }
+
+  *data = &single_pixel_buffer->argb8888;
+  *format = DRM_FORMAT_ARGB8888;
+  *stride = sizeof(single_pixel_buffer->argb8888);
+
+  return true;
+}
+
+static void
+buffer_end_data_ptr_access(struct wlr_buffer *wlr_buffer)
+{}
+
+static const struct wlr_buffer_impl buffer_impl = {
+  .destroy = buffer_destroy,
+  .begin_data_ptr_access = buffer_begin_data_ptr_access,
+  .end_data_ptr_access = buffer_end_data_ptr_access,
+};
+
+static void
+release_handler(struct wl_listener *listener, void *data)
+{
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      wl_container_of(listener, single_pixel_buffer, release);
+
+  if (single_pixel_buffer->resource != NULL) {
+    wl_buffer_send_release(single_pixel_buffer->resource);
+  }
+}
+
+static void
+resource_destroy_handler(struct wl_resource *resource)
+{
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      single_pixel_buffer_from_resource(resource);
+
+  single_pixel_buffer->resource = NULL;
+  wlr_buffer_drop(&single_pixel_buffer->buffer);
+}
+
+static inline uint8_t
+channel_to_u8(uint32_t channel)
+{
+  return channel >> 24;
+}
+
+static inline float
+channel_to_float(uint32_t channel)
+{
+  return (double)channel / UINT32_MAX;
+}
+
+static void
+manager_handle_destroy(struct wl_client *client, struct wl_resource *resource)
+{
+  wl_resource_destroy(resource);
+}
+
+static void
+manager_handle_create_u32_rgba_buffer(struct wl_client *client,
+    struct wl_resource *resource,
+    uint32_t id,
+    uint32_t r,
+    uint32_t g,
+    uint32_t b,
+    uint32_t a)
+{
+  struct hikari_single_pixel_buffer *single_pixel_buffer =
+      hikari_calloc(1, sizeof(struct hikari_single_pixel_buffer));
+
+  if (single_pixel_buffer == NULL) {
+    wl_client_post_no_memory(client);
+    return;
+  }
+
+  single_pixel_buffer->resource = wl_resource_create(client,
+      &wl_buffer_interface,
+      wl_resource_get_version(resource),
+      id);
+
+  if (single_pixel_buffer->resource == NULL) {
+    wl_client_post_no_memory(client);
+    hikari_free(single_pixel_buffer);
+    return;
+  }
+
+  wlr_buffer_init(&single_pixel_buffer->buffer, &buffer_impl, 1, 1);
+
+  wl_resource_set_implementation(single_pixel_buffer->resource,
+      &wl_buffer_impl,
+      single_pixel_buffer,
+      resource_destroy_handler);
+
+  // channels are premultiplied, just like the colors the renderer expects.
+  single_pixel_buffer->argb8888 = (uint32_t)channel_to_u8(a) << 24 |
+                                  (uint32_t)channel_to_u8(r) << 16 |
+                                  (uint32_t)channel_to_u8(g) << 8 |
+                                  (uint32_t)channel_to_u8(b);
+
+  single_pixel_buffer->color[0] = channel_to_float(r);
+  single_pixel_buffer->color[1] = channel_to_float(g);
+  single_pixel_buffer->color[2] = channel_to_float(b);
+  single_pixel_buffer->color[3] = channel_to_float(a);
+
+  single_pixel_buffer->release.notify = release_handler;
+  wl_signal_add(&single_pixel_buffer->buffer.events.release,
+      &single_pixel_buffer->release);
+}
+
+static const struct wp_single_pixel_buffer_manager_v1_interface manager_impl = {
+  .destroy = manager_handle_destroy,
+  .create_u32_rgba_buffer = manager_handle_create_u32_rgba_buffer,
+};
+
+static void
+manager_bind(
+    struct wl_client *client, void *data, uint32_t version, uint32_t id)
+{
+  struct wl_resource *resource = wl_resource_create(
+      client, &wp_single_pixel_buffer_manager_v1_interface, version, id);
+
+  if (resource == NULL) {
+    wl_client_post_no_memory(client);
+    return;
+  }
+
+  wl_resource_set_implementation(resource, &manager_impl, NULL, NULL);
+}
+
+struct wl_global *
+hikari_single_pixel_buffer_manager_create(struct wl_display *display)
+{
+  struct wl_global *global = wl_global_create(display,
+      &wp_single_pixel_buffer_manager_v1_interface,
+      SINGLE_PIXEL_BUFFER_MANAGER_VERSION,
+      NULL,
+      manager_bind);
+
+  if (global == NULL) {
+    return NULL;
+  }
+
+  wlr_buffer_register_resource_interface(&buffer_resource_interface);
+
+  return global;
+}
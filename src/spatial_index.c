@@ -0,0 +1,273 @@
+#include <hikari/spatial_index.h>
+
+#include <assert.h>
+
+#include <hikari/memory.h>
+#include <hikari/node.h>
+#include <hikari/output.h>
+#include <hikari/view.h>
+#include <hikari/workspace.h>
+
+#define CELL_SIZE 256
+
+// incremented on every invalidation of any index, results of hit-tests are
+// only valid as long as it did not change.
+static unsigned long generation = 0;
+
+void
+hikari_spatial_index_init(struct hikari_spatial_index *spatial_index)
+{
+  spatial_index->dirty = true;
+  spatial_index->entries = NULL;
+  spatial_index->nr_entries = 0;
+  spatial_index->capacity = 0;
+  spatial_index->cells = NULL;
+  spatial_index->columns = 0;
+  spatial_index->rows = 0;
+}
+
+static void
+clear_cells(struct hikari_spatial_index *spatial_index)
+{
+  int nr_cells = spatial_index->columns * spatial_index->rows;
+
+  for (int i = 0; i < nr_cells; i++) {
+    hikari_free(spatial_index->cells[i].entries);
+  }
+
+  hikari_free(spatial_index->cells);
+
+  spatial_index->cells = NULL;
+  spatial_index->columns = 0;
+  spatial_index->rows = 0;
+}
+
+void
+hikari_spatial_index_fini(struct hikari_spatial_index *spatial_index)
+{
+  clear_cells(spatial_index);
+  hikari_free(spatial_index->entries);
+}
+
+void
+hikari_spatial_index_invalidate(struct hikari_spatial_index *spatial_index)
+{
+  spatial_index->dirty = true;
+  generation++;
+}
+
+unsigned long
+hikari_spatial_index_generation(void)
+{
+  return generation;
+}
+
+static void
+extend_box(struct wlr_box *box, struct wlr_box *other)
+{
+  int x1 = box->x < other->x ? box->x : other->x;
+  int y1 = box->y < other->y ? box->y : other->y;
+  int x2 = box->x + box->width > other->x + other->width
+               ? box->x + box->width
+               : other->x + other->width;
+  int y2 = box->y + box->height > other->y + other->height
+               ? box->y + box->height
+               : other->y + other->height;
+
+  box->x = x1;
+  box->y = y1;
+  box->width = x2 - x1;
+  box->height = y2 - y1;
+}
+
+static void
+extend_surface_box(struct wlr_surface *surface, int sx, int sy, void *data)
+{
+  struct hikari_spatial_index_entry *entry = data;
+  struct wlr_box *geometry = hikari_view_geometry(entry->view);
+
+  struct wlr_box box = { .x = geometry->x + sx,
+    .y = geometry->y + sy,
+    .width = surface->current.width,
+    .height = surface->current.height };
+
+  extend_box(&entry->box, &box);
+}
+
+static void
+add_entry(struct hikari_spatial_index *spatial_index, struct hikari_view *view)
+{
+  if (spatial_index->nr_entries == spatial_index->capacity) {
+    spatial_index->capacity =
+        spatial_index->capacity == 0 ? 16 : spatial_index->capacity * 2;
+    spatial_index->entries = hikari_realloc(spatial_index->entries,
+        spatial_index->capacity * sizeof(struct hikari_spatial_index_entry));
+  }
+
+  struct hikari_spatial_index_entry *entry =
+      &spatial_index->entries[spatial_index->nr_entries++];
+
+  entry->view = view;
+  entry->box = *hikari_view_border_geometry(view);
+
+  // client side decorations and child surfaces can extend beyond the border
+  // geometry.
+  if (view->use_csd || !wl_list_empty(&view->children)) {
+    hikari_node_for_each_surface(
+        (struct hikari_node *)view, extend_surface_box, entry);
+  }
+}
+
+static void
+add_to_cell(struct hikari_spatial_index_cell *cell, size_t entry)
+{
+  if (cell->nr_entries == cell->capacity) {
+    cell->capacity = cell->capacity == 0 ? 8 : cell->capacity * 2;
+    cell->entries =
+        hikari_realloc(cell->entries, cell->capacity * sizeof(size_t));
+  }
+
+  cell->entries[cell->nr_entries++] = entry;
+}
+
+static inline int
+clamp(int value, int min, int max)
+{
+  if (value < min) {
+    return min;
+  } else if (value > max) {
+    return max;
+  } else {
+    return value;
+  }
+}
+
+static void
+rebuild(
+    struct hikari_spatial_index *spatial_index, struct hikari_output *output)
+{
+  int columns = (output->geometry.width + CELL_SIZE - 1) / CELL_SIZE;
+  int rows = (output->geometry.height + CELL_SIZE - 1) / CELL_SIZE;
+
+  if (columns < 1) {
+    columns = 1;
+  }
+
+  if (rows < 1) {
+    rows = 1;
+  }
+
+  if (columns != spatial_index->columns || rows != spatial_index->rows) {
+    clear_cells(spatial_index);
+
+    spatial_index->cells =
+        hikari_calloc(columns * rows, sizeof(struct hikari_spatial_index_cell));
+    spatial_index->columns = columns;
+    spatial_index->rows = rows;
+  } else {
+    for (int i = 0; i < columns * rows; i++) {
+      spatial_index->cells[i].nr_entries = 0;
+    }
+  }
+
+  spatial_index->nr_entries = 0;
+
+  // entries are added in stacking order, every cell ends up sorted from the
+  // topmost to the bottommost view.
+  struct hikari_view *view;
+  wl_list_for_each (view, &output->workspace->views, workspace_views) {
+    add_entry(spatial_index, view);
+  }
+
+  for (size_t i = 0; i < spatial_index->nr_entries; i++) {
+    struct wlr_box *box = &spatial_index->entries[i].box;
+
+    if (box->width <= 0 || box->height <= 0) {
+      continue;
+    }
+
+    int x1 = clamp(box->x / CELL_SIZE, 0, columns - 1);
+    int y1 = clamp(box->y / CELL_SIZE, 0, rows - 1);
+    int x2 = clamp((box->x + box->width - 1) / CELL_SIZE, 0, columns - 1);
+    int y2 = clamp((box->y + box->height - 1) / CELL_SIZE, 0, rows - 1);
+
+    for (int y = y1; y <= y2; y++) {
+      for (int x = x1; x <= x2; x++) {
+        add_to_cell(&spatial_index->cells[y * columns + x], i);
+      }
+    }
+  }
+
+  spatial_index->dirty = false;
+}
+
+struct hikari_view *
+hikari_spatial_index_view_at(struct hikari_spatial_index *spatial_index,
+    struct hikari_output *output,
+    double ox,
+    double oy,
+    struct wlr_surface **surface,
+    double *sx,
+    double *sy)
+{
+  assert(output != NULL);
+
+  if (spatial_index->dirty) {
+    rebuild(spatial_index, output);
+  }
+
+  int column = clamp(ox / CELL_SIZE, 0, spatial_index->columns - 1);
+  int row = clamp(oy / CELL_SIZE, 0, spatial_index->rows - 1);
+
+  struct hikari_spatial_index_cell *cell =
+      &spatial_index->cells[row * spatial_index->columns + column];
+
+  for (size_t i = 0; i < cell->nr_entries; i++) {
+    struct hikari_spatial_index_entry *entry =
+        &spatial_index->entries[cell->entries[i]];
+
+    if (!wlr_box_contains_point(&entry->box, ox, oy)) {
+      continue;
+    }
+
+    double out_sx, out_sy;
+    struct wlr_surface *out_surface = hikari_node_surface_at(
+        (struct hikari_node *)entry->view, ox, oy, &out_sx, &out_sy);
+
+    if (out_surface != NULL) {
+      *sx = out_sx;
+      *sy = out_sy;
+      *surface = out_surface;
+      return entry->view;
+    }
+  }
+
+  return NULL;
+}
+
+bool
+hikari_spatial_index_is_exposed(struct hikari_spatial_index *spatial_index,
+    struct hikari_node *node,
+    struct wlr_surface *surface,
+    struct wlr_box *box)
+{
+  assert(!spatial_index->dirty);
+
+  struct wlr_box intersection;
+
+  for (size_t i = 0; i < spatial_index->nr_entries; i++) {
+    struct hikari_spatial_index_entry *entry = &spatial_index->entries[i];
+    struct hikari_view *view = entry->view;
+
+    if ((struct hikari_node *)view == node) {
+      // child surfaces of the view itself could cover the surface.
+      return view->surface == surface && wl_list_empty(&view->children);
+    }
+
+    if (wlr_box_intersection(&intersection, &entry->box, box)) {
+      return false;
+    }
+  }
+
+  return false;
+}
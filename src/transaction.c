@@ -0,0 +1,49 @@
+#include <hikari/transaction.h>
+
+#include <assert.h>
+
+#include <hikari/indicator.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+#include <hikari/view.h>
+
+void
+hikari_transaction_init(struct hikari_transaction *transaction)
+{
+  transaction->depth = 0;
+}
+
+void
+hikari_transaction_begin(struct hikari_transaction *transaction)
+{
+  if (transaction->depth++ > 0) {
+    return;
+  }
+
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    hikari_output_defer_damage(output);
+  }
+}
+
+void
+hikari_transaction_commit(struct hikari_transaction *transaction)
+{
+  assert(transaction->depth > 0);
+
+  if (--transaction->depth > 0) {
+    return;
+  }
+
+  // submit the union of all damage collected during the transaction at once.
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    hikari_output_flush_damage(output);
+  }
+
+  struct hikari_view *focus_view = hikari_server.workspace->focus_view;
+
+  if (focus_view != NULL && hikari_server_is_indicating()) {
+    hikari_indicator_refresh(&hikari_server.indicator, focus_view);
+  }
+}
@@ -7,6 +7,7 @@
 
 #include <hikari/color.h>
 #include <hikari/configuration.h>
+#include <hikari/fractional_scale.h>
 #include <hikari/geometry.h>
 #include <hikari/group.h>
 #include <hikari/indicator.h>
@@ -46,6 +47,17 @@ VIEW(first, next)
 VIEW(last, prev)
 #undef VIEW
 
+static void
+invalidate_spatial_indices(void)
+{
+  // views can change their workspace while being restacked, invalidate all
+  // outputs instead of keeping track of the previous one.
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    hikari_spatial_index_invalidate(&output->spatial_index);
+  }
+}
+
 static void
 move_to_top(struct hikari_view *view)
 {
@@ -81,6 +93,8 @@ place_visibly_above(
 
   wl_list_remove(&view->workspace_views);
   wl_list_insert(&workspace->views, &view->workspace_views);
+
+  invalidate_spatial_indices();
 }
 
 static void
@@ -98,55 +112,70 @@ refresh_border_geometry(struct hikari_view *view)
   assert(view != NULL);
   hikari_border_refresh_geometry(&view->border, view->current_geometry);
   hikari_indicator_frame_refresh_geometry(&view->indicator_frame, view);
-}
 
-static inline void
-move_view_constrained(
-    struct hikari_view *view, struct wlr_box *geometry, int x, int y)
-{
-  if (!hikari_view_is_hidden(view)) {
-    hikari_view_damage_whole(view);
-    hikari_indicator_damage(&hikari_server.indicator, view);
+  if (view->output != NULL) {
+    hikari_spatial_index_invalidate(&view->output->spatial_index);
   }
-
-  hikari_geometry_constrain_relative(
-      geometry, &view->output->usable_area, x, y);
 }
 
+static void
+damage_view_region(struct hikari_view *view, pixman_region32_t *region);
+
 static void
 move_view(struct hikari_view *view, struct wlr_box *geometry, int x, int y)
 {
-  if (view->maximized_state != NULL) {
-    struct wlr_box *usable_area;
+  struct wlr_box *usable_area = &view->output->usable_area;
 
+  if (view->maximized_state != NULL) {
     switch (view->maximized_state->maximization) {
       case HIKARI_MAXIMIZATION_FULLY_MAXIMIZED:
         return;
 
       case HIKARI_MAXIMIZATION_VERTICALLY_MAXIMIZED:
-        usable_area = &view->output->usable_area;
-
         if (y != usable_area->y) {
           return;
         }
-
-        move_view_constrained(view, geometry, x, y);
-        view->geometry.x = x;
         break;
 
       case HIKARI_MAXIMIZATION_HORIZONTALLY_MAXIMIZED:
-        usable_area = &view->output->usable_area;
-
         if (x != usable_area->x) {
           return;
         }
+        break;
+    }
+  }
+
+  bool visible = !hikari_view_is_hidden(view);
+
+  // collect the damage of the old and the new position into one region.
+  pixman_region32_t damage;
+  pixman_region32_init(&damage);
+
+  if (visible) {
+    damage_view_region(view, &damage);
+    hikari_indicator_damage(&hikari_server.indicator, view);
+
+#ifndef NDEBUG
+    hikari_server.statistics.moves++;
+    hikari_server.statistics.move_damage_submissions++;
+#endif
+  }
+
+  hikari_geometry_constrain_relative(geometry, usable_area, x, y);
+
+  if (view->maximized_state != NULL) {
+    switch (view->maximized_state->maximization) {
+      case HIKARI_MAXIMIZATION_FULLY_MAXIMIZED:
+        break;
+
+      case HIKARI_MAXIMIZATION_VERTICALLY_MAXIMIZED:
+        view->geometry.x = x;
+        break;
 
-        move_view_constrained(view, geometry, x, y);
+      case HIKARI_MAXIMIZATION_HORIZONTALLY_MAXIMIZED:
         view->geometry.y = y;
         break;
     }
-  } else {
-    move_view_constrained(view, geometry, x, y);
   }
 
 #ifdef HAVE_XWAYLAND
@@ -157,10 +186,18 @@ move_view(struct hikari_view *view, struct wlr_box *geometry, int x, int y)
 
   refresh_border_geometry(view);
 
-  if (!hikari_view_is_hidden(view)) {
-    hikari_view_damage_whole(view);
+  if (visible) {
+    damage_view_region(view, &damage);
+    hikari_output_add_damage_region(view->output, &damage);
     hikari_indicator_damage(&hikari_server.indicator, view);
+
+#ifndef NDEBUG
+    // the view region and the indicator are submitted separately.
+    hikari_server.statistics.move_damage_submissions += 2;
+#endif
   }
+
+  pixman_region32_fini(&damage);
 }
 
 static void
@@ -199,6 +236,8 @@ hide(struct hikari_view *view)
   wl_list_remove(&view->workspace_views);
   wl_list_init(&view->workspace_views);
 
+  invalidate_spatial_indices();
+
   wl_list_remove(&view->visible_server_views);
   wl_list_init(&view->visible_server_views);
 
@@ -253,6 +292,7 @@ guarded_resize(struct hikari_view *view,
   if (op->serial == 0) {
     f(view, op);
   } else {
+    clock_gettime(CLOCK_MONOTONIC, &op->issued);
     hikari_view_set_dirty(view);
   }
 }
@@ -271,6 +311,7 @@ resize(struct hikari_view *view,
         op->geometry.width,
         op->geometry.height);
 
+    clock_gettime(CLOCK_MONOTONIC, &op->issued);
     hikari_view_set_dirty(view);
   } else {
     guarded_resize(view, op, f);
@@ -431,6 +472,14 @@ hikari_view_init(
 
   hikari_view_unset_dirty(view);
   view->pending_operation.tile = NULL;
+  view->pending_operation.issued = (struct timespec){ 0 };
+  view->queued_resize.pending = false;
+  view->configure_rtt_msec = 0;
+  view->max_configure_rtt_msec = 0;
+  view->title_changes.second = 0;
+  view->title_changes.changes = 0;
+  view->title_changes.rate = 0;
+  view->title_changes.total = 0;
 
   wl_list_init(&view->children);
 }
@@ -476,23 +525,59 @@ hikari_view_fini(struct hikari_view *view)
   cancel_tile(view);
 }
 
+static void
+count_title_change(struct hikari_view *view)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  if (now.tv_sec == view->title_changes.second) {
+    view->title_changes.changes++;
+  } else {
+    // the rate is the number of changes during the last full second.
+    view->title_changes.rate = now.tv_sec == view->title_changes.second + 1
+                                   ? view->title_changes.changes
+                                   : 0;
+    view->title_changes.second = now.tv_sec;
+    view->title_changes.changes = 1;
+  }
+
+  view->title_changes.total++;
+}
+
 void
 hikari_view_set_title(struct hikari_view *view, const char *title)
 {
+  if (title != NULL && view->title != NULL && !strcmp(title, view->title)) {
+    return;
+  }
+
+  count_title_change(view);
+
   hikari_free(view->title);
 
   if (title != NULL) {
     view->title = hikari_malloc(strlen(title) + 1);
     strcpy(view->title, title);
-
-    if (hikari_server.workspace->focus_view == view) {
-      assert(!hikari_view_is_hidden(view));
-      struct hikari_output *output = view->output;
-      hikari_indicator_update_title(&hikari_server.indicator, output, title);
-    }
   } else {
     view->title = NULL;
   }
+
+  if (hikari_server.workspace->focus_view == view) {
+    assert(!hikari_view_is_hidden(view));
+
+    struct hikari_indicator *indicator = &hikari_server.indicator;
+
+    if (hikari_server_is_indicating()) {
+      // rasterizing is deferred to the next frame, changes in between are
+      // coalesced.
+      indicator->title_pending = true;
+      hikari_indicator_damage_title(
+          indicator, view->output, hikari_view_border_geometry(view));
+    } else {
+      hikari_indicator_invalidate(indicator);
+    }
+  }
 }
 
 static void
@@ -512,55 +597,112 @@ struct hikari_damage_data {
 
   struct hikari_view *view;
   struct hikari_output *output;
+  pixman_region32_t *region;
 
   bool whole;
 };
 
+static void
+add_damage(struct hikari_damage_data *damage_data, struct wlr_box *box)
+{
+  if (damage_data->region != NULL) {
+    pixman_region32_union_rect(damage_data->region,
+        damage_data->region,
+        box->x,
+        box->y,
+        box->width,
+        box->height);
+  } else {
+    hikari_output_add_damage(damage_data->output, box);
+  }
+}
+
 static void
 damage_whole_surface(struct wlr_surface *surface, int sx, int sy, void *data)
 {
   struct hikari_damage_data *damage_data = data;
-  struct hikari_output *output = damage_data->output;
   struct hikari_view *view = damage_data->view;
 
-  if (view->surface == surface) {
-    hikari_view_damage_border(view);
-  } else {
-    struct wlr_box geometry;
-    memcpy(&geometry, damage_data->geometry, sizeof(struct wlr_box));
-
-    geometry.x += sx;
-    geometry.y += sy;
-    geometry.width = surface->current.width;
-    geometry.height = surface->current.height;
+  if (damage_data->whole && view->surface == surface) {
+    add_damage(damage_data, hikari_view_border_geometry(view));
 
-    hikari_output_add_damage(output, &geometry);
+    // the border geometry covers server side decorated surfaces, client side
+    // decorated ones extend beyond it by the size of their shadows.
+    if (!view->use_csd) {
+      return;
+    }
   }
+
+  struct wlr_box geometry;
+  memcpy(&geometry, damage_data->geometry, sizeof(struct wlr_box));
+
+  geometry.x += sx;
+  geometry.y += sy;
+  geometry.width = surface->current.width;
+  geometry.height = surface->current.height;
+
+  add_damage(damage_data, &geometry);
 }
 
-void
-hikari_view_damage_whole(struct hikari_view *view)
+static void
+damage_view(struct hikari_view *view, pixman_region32_t *region, bool whole)
 {
   assert(view != NULL);
 
-  struct hikari_output *output = view->output;
-
-  // TODO I know, this needs to be done A LOT better
-  if (view->use_csd) {
-    hikari_output_damage_whole(output);
-    return;
-  }
-
   struct hikari_damage_data damage_data;
 
   damage_data.geometry = hikari_view_geometry(view);
-  damage_data.output = output;
+  damage_data.output = view->output;
   damage_data.view = view;
+  damage_data.region = region;
+  damage_data.whole = whole;
 
   hikari_node_for_each_surface(
       (struct hikari_node *)view, damage_whole_surface, &damage_data);
 }
 
+static void
+damage_view_region(struct hikari_view *view, pixman_region32_t *region)
+{
+  damage_view(view, region, true);
+}
+
+void
+hikari_view_damage_whole(struct hikari_view *view)
+{
+  damage_view(view, NULL, true);
+}
+
+void
+hikari_view_damage_content(struct hikari_view *view)
+{
+  damage_view(view, NULL, false);
+}
+
+void
+hikari_view_damage_border(struct hikari_view *view)
+{
+  assert(view != NULL);
+
+  struct hikari_output *output = view->output;
+  struct hikari_border *border = &view->border;
+  struct hikari_indicator_frame *indicator_frame = &view->indicator_frame;
+
+  if (border->state != HIKARI_BORDER_NONE) {
+    hikari_output_add_damage(output, &border->top);
+    hikari_output_add_damage(output, &border->bottom);
+    hikari_output_add_damage(output, &border->left);
+    hikari_output_add_damage(output, &border->right);
+  }
+
+  // indicator frames are drawn inside of the view geometry when there is no
+  // border to draw them on.
+  hikari_output_add_damage(output, &indicator_frame->top);
+  hikari_output_add_damage(output, &indicator_frame->bottom);
+  hikari_output_add_damage(output, &indicator_frame->left);
+  hikari_output_add_damage(output, &indicator_frame->right);
+}
+
 static struct wlr_box *
 refresh_unmaximized_geometry(struct hikari_view *view)
 {
@@ -661,6 +803,46 @@ queue_resize(struct hikari_view *view,
   resize(view, op, commit_resize);
 }
 
+// geometry the view is going to end up with once all outstanding requests
+// have been handled, returns `NULL` if the in-flight operation is not a resize
+// and the request should be dropped.
+static struct wlr_box *
+requested_geometry(struct hikari_view *view, struct wlr_box *geometry)
+{
+  if (!hikari_view_is_dirty(view)) {
+    return hikari_view_geometry(view);
+  }
+
+  if (view->pending_operation.type != HIKARI_OPERATION_TYPE_RESIZE) {
+    return NULL;
+  }
+
+  if (view->queued_resize.pending) {
+    geometry->x = view->queued_resize.x;
+    geometry->y = view->queued_resize.y;
+    geometry->width = view->queued_resize.width;
+    geometry->height = view->queued_resize.height;
+  } else {
+    *geometry = view->pending_operation.geometry;
+  }
+
+  return geometry;
+}
+
+static void
+request_resize(struct hikari_view *view, int x, int y, int width, int height)
+{
+  if (hikari_view_is_dirty(view)) {
+    view->queued_resize.pending = true;
+    view->queued_resize.x = x;
+    view->queued_resize.y = y;
+    view->queued_resize.width = width;
+    view->queued_resize.height = height;
+  } else {
+    queue_resize(view, hikari_view_geometry(view), x, y, width, height);
+  }
+}
+
 void
 hikari_view_resize(struct hikari_view *view, int dwidth, int dheight)
 {
@@ -668,17 +850,17 @@ hikari_view_resize(struct hikari_view *view, int dwidth, int dheight)
   assert(view->resize != NULL);
   assert(view->constraints != NULL);
 
-  if (hikari_view_is_dirty(view)) {
+  struct wlr_box requested;
+  struct wlr_box *geometry = requested_geometry(view, &requested);
+
+  if (geometry == NULL) {
     return;
   }
 
-  struct wlr_box *geometry = hikari_view_geometry(view);
-
   int requested_width = geometry->width + dwidth;
   int requested_height = geometry->height + dheight;
 
-  queue_resize(view,
-      geometry,
+  request_resize(view,
       geometry->x,
       geometry->y,
       requested_width,
@@ -692,12 +874,14 @@ hikari_view_resize_absolute(struct hikari_view *view, int width, int height)
   assert(view->resize != NULL);
   assert(view->constraints != NULL);
 
-  if (hikari_view_is_dirty(view)) {
+  struct wlr_box requested;
+  struct wlr_box *geometry = requested_geometry(view, &requested);
+
+  if (geometry == NULL) {
     return;
   }
 
-  struct wlr_box *geometry = hikari_view_geometry(view);
-  queue_resize(view, geometry, geometry->x, geometry->y, width, height);
+  request_resize(view, geometry->x, geometry->y, width, height);
 }
 
 void
@@ -708,19 +892,19 @@ hikari_view_move_resize(
   assert(view->resize != NULL);
   assert(view->constraints != NULL);
 
-  if (hikari_view_is_dirty(view)) {
+  struct wlr_box requested;
+  struct wlr_box *geometry = requested_geometry(view, &requested);
+
+  if (geometry == NULL) {
     return;
   }
 
-  struct wlr_box *geometry = hikari_view_geometry(view);
-
   int requested_x = geometry->x + x;
   int requested_y = geometry->y + y;
   int requested_width = geometry->width + width;
   int requested_height = geometry->height + height;
 
-  queue_resize(view,
-      geometry,
+  request_resize(view,
       requested_x,
       requested_y,
       requested_width,
@@ -785,7 +969,31 @@ new_subsurface_handler(struct wl_listener *listener, void *data)
   struct hikari_view_subsurface *view_subsurface =
       hikari_malloc(sizeof(struct hikari_view_subsurface));
 
-  hikari_view_subsurface_init(view_subsurface, view, wlr_subsurface);
+  hikari_view_subsurface_init(view_subsurface, view, NULL, wlr_subsurface);
+}
+
+static void
+send_preferred_scale(struct wlr_surface *surface, int sx, int sy, void *data)
+{
+  double *scale = data;
+
+  hikari_fractional_scale_notify(surface, *scale);
+}
+
+void
+hikari_view_refresh_scale(struct hikari_view *view)
+{
+  assert(view != NULL);
+  assert(view->output != NULL);
+
+  if (view->surface == NULL) {
+    return;
+  }
+
+  double scale = view->output->wlr_output->scale;
+
+  hikari_node_for_each_surface(
+      (struct hikari_node *)view, send_preferred_scale, &scale);
 }
 
 void
@@ -814,14 +1022,14 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
     struct hikari_view_subsurface *subsurface =
         (struct hikari_view_subsurface *)malloc(
             sizeof(struct hikari_view_subsurface));
-    hikari_view_subsurface_init(subsurface, view, wlr_subsurface);
+    hikari_view_subsurface_init(subsurface, view, NULL, wlr_subsurface);
   }
   wl_list_for_each (
       wlr_subsurface, &surface->current.subsurfaces_above, current.link) {
     struct hikari_view_subsurface *subsurface =
         (struct hikari_view_subsurface *)malloc(
             sizeof(struct hikari_view_subsurface));
-    hikari_view_subsurface_init(subsurface, view, wlr_subsurface);
+    hikari_view_subsurface_init(subsurface, view, NULL, wlr_subsurface);
   }
 
   if (view_config != NULL) {
@@ -850,6 +1058,8 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
   wl_list_insert(&group->views, &view->group_views);
   wl_list_insert(&output->views, &view->output_views);
 
+  hikari_view_refresh_scale(view);
+
   if (!hikari_server_in_lock_mode() || hikari_view_is_public(view)) {
     hikari_view_show(view);
 
@@ -935,6 +1145,8 @@ hikari_view_unmap(struct hikari_view *view)
   wl_list_init(&view->output_views);
 
   hikari_view_unset_dirty(view);
+  view->pending_operation.issued = (struct timespec){ 0 };
+  view->queued_resize.pending = false;
 
   assert(!hikari_view_is_tiling(view));
   assert(!hikari_view_is_tiled(view));
@@ -1021,6 +1233,8 @@ hikari_view_lower(struct hikari_view *view)
   wl_list_remove(&view->workspace_views);
   wl_list_insert(view->sheet->workspace->views.prev, &view->workspace_views);
 
+  invalidate_spatial_indices();
+
   wl_list_remove(&view->visible_server_views);
   wl_list_insert(hikari_server.visible_views.prev, &view->visible_server_views);
 
@@ -1398,6 +1612,8 @@ hikari_view_evacuate(struct hikari_view *view, struct hikari_sheet *sheet)
   view->output = sheet->workspace->output;
   view->sheet = sheet;
 
+  hikari_view_refresh_scale(view);
+
   if (!hikari_view_is_hidden(view)) {
     if (hikari_view_is_forced(view)) {
       move_to_top(view);
@@ -1588,9 +1804,22 @@ destroy_subsurface_handler(struct wl_listener *listener, void *data)
   hikari_free(view_subsurface);
 }
 
+static void
+subsurface_position(struct hikari_view_child *view_child, int *sx, int *sy)
+{
+  struct hikari_view_subsurface *view_subsurface =
+      (struct hikari_view_subsurface *)view_child;
+
+  struct wlr_subsurface *subsurface = view_subsurface->subsurface;
+
+  *sx = subsurface->current.x;
+  *sy = subsurface->current.y;
+}
+
 void
 hikari_view_subsurface_init(struct hikari_view_subsurface *view_subsurface,
     struct hikari_view *parent,
+    struct hikari_view_child *parent_child,
     struct wlr_subsurface *subsurface)
 {
   view_subsurface->subsurface = subsurface;
@@ -1599,8 +1828,24 @@ hikari_view_subsurface_init(struct hikari_view_subsurface *view_subsurface,
   wl_signal_add(
       &subsurface->surface->events.destroy, &view_subsurface->destroy);
 
-  hikari_view_child_init(
-      (struct hikari_view_child *)view_subsurface, parent, subsurface->surface);
+  hikari_view_child_init((struct hikari_view_child *)view_subsurface,
+      parent,
+      parent_child,
+      subsurface->surface);
+
+  view_subsurface->view_child.position = subsurface_position;
+}
+
+static void
+detach_descendants(struct hikari_view_child *view_child)
+{
+  struct hikari_view_child *child;
+  wl_list_for_each (child, &view_child->parent->children, link) {
+    if (child->parent_child == view_child && !child->detached) {
+      child->detached = true;
+      detach_descendants(child);
+    }
+  }
 }
 
 void
@@ -1609,6 +1854,17 @@ hikari_view_child_fini(struct hikari_view_child *view_child)
   wl_list_remove(&view_child->link);
   wl_list_remove(&view_child->commit.link);
   wl_list_remove(&view_child->new_subsurface.link);
+
+  // descendants can outlive this child, they must not reach it through
+  // their offset computation anymore.
+  detach_descendants(view_child);
+
+  struct hikari_view_child *child;
+  wl_list_for_each (child, &view_child->parent->children, link) {
+    if (child->parent_child == view_child) {
+      child->parent_child = NULL;
+    }
+  }
 }
 
 void
@@ -1634,16 +1890,6 @@ damage_surface(struct wlr_surface *surface, int sx, int sy, void *data)
   }
 }
 
-static void
-damage_single_surface(struct wlr_surface *surface, int sx, int sy, void *data)
-{
-  struct hikari_damage_data *damage_data = data;
-
-  if (damage_data->surface == surface) {
-    damage_surface(surface, sx, sy, data);
-  }
-}
-
 static void
 commit_child_handler(struct wl_listener *listener, void *data)
 {
@@ -1652,21 +1898,21 @@ commit_child_handler(struct wl_listener *listener, void *data)
 
   struct hikari_view *parent = view_child->parent;
 
-  if (!hikari_view_is_hidden(parent)) {
-    struct wlr_surface *surface = view_child->surface;
-
-    hikari_view_damage_surface(parent, surface, false);
+  if (!view_child->detached && !hikari_view_is_hidden(parent)) {
+    hikari_view_child_damage(view_child, false);
   }
 }
 
 static void
-view_subsurface_create(
-    struct wlr_subsurface *wlr_subsurface, struct hikari_view *parent)
+view_subsurface_create(struct wlr_subsurface *wlr_subsurface,
+    struct hikari_view *parent,
+    struct hikari_view_child *parent_child)
 {
   struct hikari_view_subsurface *view_subsurface =
       hikari_malloc(sizeof(struct hikari_view_subsurface));
 
-  hikari_view_subsurface_init(view_subsurface, parent, wlr_subsurface);
+  hikari_view_subsurface_init(
+      view_subsurface, parent, parent_child, wlr_subsurface);
 }
 
 static void
@@ -1677,16 +1923,24 @@ new_subsurface_child_handler(struct wl_listener *listener, void *data)
 
   struct wlr_subsurface *wlr_subsurface = data;
 
-  view_subsurface_create(wlr_subsurface, view_child->parent);
+  view_subsurface_create(wlr_subsurface, view_child->parent, view_child);
 }
 
 void
 hikari_view_child_init(struct hikari_view_child *view_child,
     struct hikari_view *parent,
+    struct hikari_view_child *parent_child,
     struct wlr_surface *surface)
 {
   view_child->parent = parent;
+  view_child->parent_child = parent_child;
+  view_child->detached = parent_child != NULL && parent_child->detached;
   view_child->surface = surface;
+  view_child->sx = 0;
+  view_child->sy = 0;
+  view_child->width = 0;
+  view_child->height = 0;
+  view_child->position = NULL;
 
   view_child->new_subsurface.notify = new_subsurface_child_handler;
   wl_signal_add(&surface->events.new_subsurface, &view_child->new_subsurface);
@@ -1699,36 +1953,71 @@ hikari_view_child_init(struct hikari_view_child *view_child,
   struct wlr_subsurface *subsurface;
   wl_list_for_each (
       subsurface, &surface->current.subsurfaces_below, current.link) {
-    view_subsurface_create(subsurface, parent);
+    view_subsurface_create(subsurface, parent, view_child);
   }
   wl_list_for_each (
       subsurface, &surface->current.subsurfaces_above, current.link) {
-    view_subsurface_create(subsurface, parent);
+    view_subsurface_create(subsurface, parent, view_child);
+  }
+}
+
+static void
+refresh_child_offset(struct hikari_view_child *view_child)
+{
+  struct hikari_view_child *parent_child = view_child->parent_child;
+
+  view_child->position(view_child, &view_child->sx, &view_child->sy);
+
+  // positions are relative to the parent surface, only ancestors need to be
+  // refreshed instead of walking the whole surface tree.
+  if (parent_child != NULL) {
+    refresh_child_offset(parent_child);
+
+    view_child->sx += parent_child->sx;
+    view_child->sy += parent_child->sy;
   }
 }
 
 void
-hikari_view_damage_surface(
-    struct hikari_view *view, struct wlr_surface *surface, bool whole)
+hikari_view_child_damage(struct hikari_view_child *view_child, bool whole)
 {
-  assert(view != NULL);
+  assert(view_child != NULL);
+  assert(view_child->position != NULL);
 
-  // TODO I know, this needs to be done A LOT better
-  if (view->use_csd) {
-    hikari_output_damage_whole(view->output);
+  // the offset of a detached child can not be computed anymore.
+  if (view_child->detached) {
     return;
   }
 
+  struct hikari_view *view = view_child->parent;
   struct hikari_damage_data damage_data;
 
   damage_data.geometry = hikari_view_geometry(view);
   damage_data.output = view->output;
-  damage_data.surface = surface;
+  damage_data.surface = view_child->surface;
+  damage_data.region = NULL;
   damage_data.whole = whole;
   damage_data.view = view;
 
-  hikari_node_for_each_surface(
-      (struct hikari_node *)view, damage_single_surface, &damage_data);
+  int sx = view_child->sx;
+  int sy = view_child->sy;
+  struct wlr_surface *surface = view_child->surface;
+
+  refresh_child_offset(view_child);
+
+  // child surfaces can grow the area covered by the view, the index only
+  // needs a rebuild when a child maps, unmaps or changes its extent.
+  if (whole || sx != view_child->sx || sy != view_child->sy ||
+      surface->current.width != view_child->width ||
+      surface->current.height != view_child->height) {
+    view_child->width = surface->current.width;
+    view_child->height = surface->current.height;
+
+    hikari_spatial_index_invalidate(&view->output->spatial_index);
+  }
+
+  damage_surface(
+      view_child->surface, view_child->sx, view_child->sy, &damage_data);
 }
 
 void
@@ -1791,8 +2080,35 @@ hikari_view_commit_pending_operation(
   hikari_indicator_damage(&hikari_server.indicator, view);
   hikari_view_damage_whole(view);
 
-  commit_operation(&view->pending_operation, view);
+  struct hikari_operation *op = &view->pending_operation;
+
+  if (op->issued.tv_sec != 0 || op->issued.tv_nsec != 0) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    view->configure_rtt_msec = (now.tv_sec - op->issued.tv_sec) * 1000 +
+                               (now.tv_nsec - op->issued.tv_nsec) / 1000000;
+
+    if (view->configure_rtt_msec > view->max_configure_rtt_msec) {
+      view->max_configure_rtt_msec = view->configure_rtt_msec;
+    }
+
+    op->issued = (struct timespec){ 0 };
+  }
+
+  commit_operation(op, view);
   hikari_view_unset_dirty(view);
+
+  if (view->queued_resize.pending && !hikari_view_is_dirty(view)) {
+    view->queued_resize.pending = false;
+
+    queue_resize(view,
+        hikari_view_geometry(view),
+        view->queued_resize.x,
+        view->queued_resize.y,
+        view->queued_resize.width,
+        view->queued_resize.height);
+  }
 }
 
 void
@@ -1817,6 +2133,8 @@ migrate_view(struct hikari_view *view, struct hikari_sheet *sheet, bool center)
   view->output = sheet->workspace->output;
   view->sheet = sheet;
 
+  hikari_view_refresh_scale(view);
+
   move_to_top(view);
 
   queue_reset(view, center);
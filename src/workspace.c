@@ -140,12 +140,16 @@ hikari_workspace_clear(struct hikari_workspace *workspace)
 {
   struct hikari_view *view = NULL, *view_tmp = NULL;
 
+  hikari_transaction_begin(&hikari_server.transaction);
+
   wl_list_for_each_reverse_safe (
       view, view_tmp, &(workspace->views), workspace_views) {
     hikari_view_hide(view);
   }
 
   hikari_server_cursor_focus();
+
+  hikari_transaction_commit(&hikari_server.transaction);
 }
 
 static void
@@ -381,6 +385,12 @@ hikari_workspace_focus_view(
   struct hikari_view *focus_view = current_workspace->focus_view;
 
   if (focus_view != NULL) {
+    // cycling renders the focus view on top of the stack, this changes more
+    // than its border.
+    if (hikari_server_is_cycling()) {
+      hikari_view_damage_whole(focus_view);
+    }
+
     if (hikari_server_is_indicating()) {
       hikari_group_damage(focus_view->group);
       hikari_indicator_damage(&hikari_server.indicator, focus_view);
@@ -413,6 +423,10 @@ hikari_workspace_focus_view(
           &wlr_keyboard->modifiers);
     }
 
+    if (hikari_server_is_cycling()) {
+      hikari_view_damage_whole(view);
+    }
+
     if (hikari_server_is_indicating()) {
       if (focus_view == NULL || focus_view->group != view->group) {
         hikari_group_damage(view->group);
@@ -421,7 +435,13 @@ hikari_workspace_focus_view(
       hikari_view_damage_border(view);
     }
 
-    hikari_indicator_update(&hikari_server.indicator, view);
+    // only rasterize the indicator when it is actually shown.
+    if (hikari_server_is_indicating() &&
+        !hikari_transaction_is_open(&hikari_server.transaction)) {
+      hikari_indicator_update(&hikari_server.indicator, view);
+    } else {
+      hikari_indicator_invalidate(&hikari_server.indicator);
+    }
   } else {
     hikari_cursor_reset_image(&hikari_server.cursor);
   }
@@ -476,6 +496,8 @@ hikari_workspace_only_view(struct hikari_workspace *workspace)
 {
   FOCUS_GUARD(workspace, focus_view);
 
+  hikari_transaction_begin(&hikari_server.transaction);
+
   struct hikari_view *view = NULL;
   struct hikari_view *view_tmp;
   wl_list_for_each_safe (view, view_tmp, &workspace->views, workspace_views) {
@@ -485,6 +507,8 @@ hikari_workspace_only_view(struct hikari_workspace *workspace)
   }
 
   hikari_server_cursor_focus();
+
+  hikari_transaction_commit(&hikari_server.transaction);
 }
 
 void
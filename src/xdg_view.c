@@ -81,6 +81,16 @@ commit_handler(struct wl_listener *listener, void *data)
     struct wlr_box new_geometry;
     wlr_xdg_surface_get_geometry(surface, &new_geometry);
 
+    // the surface can outgrow its window geometry (e.g. client side
+    // shadows), the index covers the whole surface.
+    if (surface->surface->current.width != xdg_view->surface_width ||
+        surface->surface->current.height != xdg_view->surface_height) {
+      xdg_view->surface_width = surface->surface->current.width;
+      xdg_view->surface_height = surface->surface->current.height;
+
+      hikari_spatial_index_invalidate(&output->spatial_index);
+    }
+
     if (new_geometry.width != geometry->width ||
         new_geometry.height != geometry->height) {
       if (visible) {
@@ -235,7 +245,8 @@ activate(struct hikari_view *view, bool active)
   if (xdg_view->surface->role == WLR_XDG_SURFACE_ROLE_TOPLEVEL) {
     wlr_xdg_toplevel_set_activated(xdg_view->surface, active);
 
-    hikari_view_damage_whole(view);
+    // the client damages its content when it commits the activated state.
+    hikari_view_damage_border(view);
   }
 }
 
@@ -316,7 +327,9 @@ destroy_popup_handler(struct wl_listener *listener, void *data)
 }
 
 static void
-xdg_popup_create(struct wlr_xdg_popup *wlr_popup, struct hikari_view *parent);
+xdg_popup_create(struct wlr_xdg_popup *wlr_popup,
+    struct hikari_view *parent,
+    struct hikari_view_child *parent_child);
 
 static void
 new_popup_popup_handler(struct wl_listener *listener, void *data)
@@ -326,7 +339,8 @@ new_popup_popup_handler(struct wl_listener *listener, void *data)
 
   struct wlr_xdg_popup *wlr_popup = data;
 
-  xdg_popup_create(wlr_popup, xdg_popup->view_child.parent);
+  xdg_popup_create(
+      wlr_popup, xdg_popup->view_child.parent, &xdg_popup->view_child);
 }
 
 static void
@@ -337,7 +351,7 @@ new_popup_handler(struct wl_listener *listener, void *data)
 
   struct wlr_xdg_popup *wlr_popup = data;
 
-  xdg_popup_create(wlr_popup, &xdg_view->view);
+  xdg_popup_create(wlr_popup, &xdg_view->view, NULL);
 }
 
 static void
@@ -350,9 +364,7 @@ popup_map(struct wl_listener *listener, void *data)
   struct hikari_xdg_popup *xdg_popup =
       wl_container_of(listener, xdg_popup, map);
 
-  struct hikari_view *parent = xdg_popup->view_child.parent;
-
-  hikari_view_damage_surface(parent, xdg_popup->view_child.surface, true);
+  hikari_view_child_damage(&xdg_popup->view_child, true);
 }
 
 static void
@@ -365,9 +377,7 @@ popup_unmap(struct wl_listener *listener, void *data)
   struct hikari_xdg_popup *xdg_popup =
       wl_container_of(listener, xdg_popup, unmap);
 
-  struct hikari_view *parent = xdg_popup->view_child.parent;
-
-  hikari_view_damage_surface(parent, xdg_popup->view_child.surface, true);
+  hikari_view_child_damage(&xdg_popup->view_child, true);
 }
 
 static void
@@ -391,7 +401,21 @@ popup_unconstrain(struct hikari_xdg_popup *popup)
 }
 
 static void
-xdg_popup_create(struct wlr_xdg_popup *wlr_popup, struct hikari_view *parent)
+popup_position(struct hikari_view_child *view_child, int *sx, int *sy)
+{
+  struct hikari_xdg_popup *xdg_popup = (struct hikari_xdg_popup *)view_child;
+
+  double popup_sx, popup_sy;
+  wlr_xdg_popup_get_position(xdg_popup->popup, &popup_sx, &popup_sy);
+
+  *sx = popup_sx;
+  *sy = popup_sy;
+}
+
+static void
+xdg_popup_create(struct wlr_xdg_popup *wlr_popup,
+    struct hikari_view *parent,
+    struct hikari_view_child *parent_child)
 {
   struct hikari_xdg_popup *popup =
       hikari_malloc(sizeof(struct hikari_xdg_popup));
@@ -417,8 +441,12 @@ xdg_popup_create(struct wlr_xdg_popup *wlr_popup, struct hikari_view *parent)
   popup->unmap.notify = popup_unmap;
   wl_signal_add(&wlr_popup->base->events.unmap, &popup->unmap);
 
-  hikari_view_child_init(
-      (struct hikari_view_child *)popup, parent, wlr_popup->base->surface);
+  hikari_view_child_init((struct hikari_view_child *)popup,
+      parent,
+      parent_child,
+      wlr_popup->base->surface);
+
+  popup->view_child.position = popup_position;
 
   popup_unconstrain(popup);
 }
@@ -473,6 +501,8 @@ hikari_xdg_view_init(struct hikari_xdg_view *xdg_view,
 
   xdg_view->surface = xdg_surface;
   xdg_view->surface->data = xdg_view;
+  xdg_view->surface_width = 0;
+  xdg_view->surface_height = 0;
 
   xdg_view->map.notify = map_handler;
   wl_signal_add(&xdg_surface->events.map, &xdg_view->map);
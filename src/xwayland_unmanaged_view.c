@@ -3,6 +3,7 @@
 
 #include <wlr/xwayland.h>
 
+#include <hikari/fractional_scale.h>
 #include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
@@ -81,6 +82,12 @@ map_handler(struct wl_listener *listener, void *data)
   wl_list_insert(&output->unmanaged_xwayland_views,
       &xwayland_unmanaged_view->unmanaged_output_views);
 
+  hikari_spatial_index_invalidate(&output->spatial_index);
+
+  // the position of unmanaged surfaces is only known once they map.
+  hikari_fractional_scale_notify(
+      xwayland_surface->surface, output->wlr_output->scale);
+
   hikari_output_add_damage(output, geometry);
 }
 
@@ -92,8 +99,10 @@ unmap(struct hikari_xwayland_unmanaged_view *xwayland_unmanaged_view)
 
   xwayland_unmanaged_view->hidden = true;
 
-  hikari_output_add_damage(xwayland_unmanaged_view->workspace->output,
-      &xwayland_unmanaged_view->geometry);
+  struct hikari_output *output = xwayland_unmanaged_view->workspace->output;
+
+  hikari_spatial_index_invalidate(&output->spatial_index);
+  hikari_output_add_damage(output, &xwayland_unmanaged_view->geometry);
 }
 
 static void